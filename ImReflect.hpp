@@ -10,4 +10,16 @@
 #include "ImReflect_macro.hpp"
 #include "ImReflect_entry.hpp"
 #include "ImReflect_primitives.hpp"
-#include "ImReflect_std.hpp"
\ No newline at end of file
+#include "ImReflect_std.hpp"
+#include "ImReflect_search.hpp"
+#include "ImReflect_multi.hpp"
+#include "ImReflect_diff.hpp"
+#include "ImReflect_undo.hpp"
+#include "ImReflect_json.hpp"
+#include "ImReflect_binary.hpp"
+#include "ImReflect_clipboard.hpp"
+#include "ImReflect_preset.hpp"
+#include "ImReflect_record.hpp"
+#include "ImReflect_remote.hpp"
+#include "ImReflect_shared.hpp"
+#include "ImReflect_proxy.hpp"
\ No newline at end of file
@@ -0,0 +1,751 @@
+#pragma once
+#include <extern/svh/tag_invoke.hpp>
+
+#include "ImReflect_macro.hpp"
+#include "ImReflect_traits.hpp"
+
+#include <charconv>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/*
+* Binary snapshots of reflected objects.
+*
+* The layout is native: snapshots are meant to be loaded by the same build (or one with
+* the same types), not exchanged between machines. A header stores a hash of the schema
+* (field names, types and sizes), loading a snapshot of a different schema fails.
+*
+* Trivially copyable values are copied with one memcpy, so are contiguous containers of them.
+* Such arrays are aligned inside the snapshot, a ``binary_array_view`` reads them in place.
+*
+* Example:
+*	std::vector<unsigned char> bytes;
+*	ImReflect::WriteBinary(scene, bytes);
+*	ImReflect::ReadBinary(bytes.data(), bytes.size(), scene);
+*
+*	ImReflect::SaveBinary("scene.bin", scene);
+*	ImReflect::LoadBinary("scene.bin", scene);
+*
+*	// No copies: the views point into the mapped file
+*	struct mesh_view { ImReflect::binary_array_view<float> vertices; }; // same names as ``mesh``
+*	ImReflect::mapped_file file("mesh.bin");
+*	ImReflect::ReadBinary(file.data(), file.size(), view);
+*/
+namespace ImReflect {
+
+	struct binary_write_t {};
+	inline constexpr binary_write_t binary_write{};
+
+	struct binary_read_t {};
+	inline constexpr binary_read_t binary_read{};
+
+	class binary_writer;
+	class binary_reader;
+
+	/* Encoded like std::vector<T>, but reading points into the snapshot instead of copying */
+	template<typename T>
+	struct binary_array_view {
+		using value_type = T;
+
+		const T* data = nullptr;
+		std::size_t size = 0;
+
+		const T* begin() const { return data; }
+		const T* end() const { return data + size; }
+		const T& operator[](std::size_t i) const { return data[i]; }
+		bool empty() const { return size == 0; }
+	};
+
+	struct binary_result {
+		const char* error = nullptr; /* nullptr on success */
+		std::size_t offset = 0;      /* where reading stopped */
+
+		explicit operator bool() const { return error == nullptr; }
+	};
+
+	namespace Detail {
+		template<typename T>
+		struct is_binary_array_view_impl : std::false_type {};
+		template<typename T>
+		struct is_binary_array_view_impl<binary_array_view<T>> : std::true_type {};
+		template<typename T>
+		constexpr bool is_binary_array_view_v = is_binary_array_view_impl<std::remove_cv_t<T>>::value;
+
+		template<typename T, typename = void>
+		struct is_contiguous_impl : std::false_type {};
+		template<typename T>
+		struct is_contiguous_impl<T, std::void_t<decltype(std::declval<T&>().data()), decltype(std::declval<T&>().resize(std::size_t{}))>>
+			: std::bool_constant<!std::is_same_v<typename T::value_type, bool>> {};
+
+		/* vector-like: data() and resize(), vector<bool> excluded */
+		template<typename T>
+		constexpr bool is_contiguous_v = is_contiguous_impl<std::remove_cv_t<T>>::value;
+
+		template<typename T>
+		constexpr bool has_binary_write_v = svh::is_tag_invocable_v<binary_write_t, binary_writer&, const T&>;
+		template<typename T>
+		constexpr bool has_binary_read_v = svh::is_tag_invocable_v<binary_read_t, binary_reader&, T&>;
+
+		template<typename T>
+		constexpr bool is_bulk();
+
+		template<typename T, std::size_t... I>
+		constexpr bool is_reflected_bulk(std::index_sequence<I...>) {
+			using ctx = visit_struct::context<ImContext>;
+			return (is_bulk<ctx::type_at<static_cast<int>(I), T>>() && ...);
+		}
+
+		/* Copied with memcpy: trivially copyable, no pointers, no custom encoding anywhere inside */
+		template<typename T>
+		constexpr bool is_bulk() {
+			using U = std::remove_cv_t<T>;
+			if constexpr (!std::is_trivially_copyable_v<U> || std::is_pointer_v<U> || std::is_member_pointer_v<U> || is_binary_array_view_v<U>) {
+				return false;
+			} else if constexpr (has_binary_write_v<U>) {
+				return false;
+			} else if constexpr (is_reflected_v<U>) {
+				return is_reflected_bulk<U>(std::make_index_sequence<visit_struct::context<ImContext>::field_count<U>()>{});
+			} else {
+				return true;
+			}
+		}
+
+		template<typename T>
+		constexpr bool is_bulk_v = is_bulk<T>();
+
+		template<typename T, typename = void>
+		struct is_bulk_array_impl : std::false_type {};
+		template<typename T>
+		struct is_bulk_array_impl<T, std::enable_if_t<is_contiguous_v<T>>> : std::bool_constant<is_bulk_v<typename T::value_type>> {};
+
+		/* Contiguous container of bulk values, one memcpy for all elements */
+		template<typename T>
+		constexpr bool is_bulk_array_v = is_bulk_array_impl<std::remove_cv_t<T>>::value;
+
+		template<typename T>
+		constexpr bool is_binary_readable();
+
+		template<typename T>
+		constexpr bool is_binary_creatable() {
+			return std::is_default_constructible_v<std::remove_cv_t<T>> && is_binary_readable<std::remove_cv_t<T>>();
+		}
+
+		template<typename T, std::size_t... I>
+		constexpr bool is_reflected_readable(std::index_sequence<I...>) {
+			using ctx = visit_struct::context<ImContext>;
+			/* const members are read into a throwaway value */
+			return ((std::is_const_v<ctx::type_at<static_cast<int>(I), T>>
+				? is_binary_creatable<ctx::type_at<static_cast<int>(I), T>>()
+				: is_binary_readable<ctx::type_at<static_cast<int>(I), T>>()) && ...);
+		}
+
+		template<typename T, std::size_t... I>
+		constexpr bool is_tuple_readable(std::index_sequence<I...>) {
+			return (is_binary_readable<std::tuple_element_t<I, T>>() && ...);
+		}
+
+		template<typename T, std::size_t... I>
+		constexpr bool is_variant_readable(std::index_sequence<I...>) {
+			return (is_binary_creatable<std::variant_alternative_t<I, T>>() && ...);
+		}
+
+		/* Whether ``binary_reader::read`` works for T: not const, and every value it creates is default constructible */
+		template<typename T>
+		constexpr bool is_binary_readable() {
+			using U = std::remove_cv_t<T>;
+			if constexpr (std::is_const_v<T>) {
+				return false;
+			} else if constexpr (has_binary_read_v<U> || is_bulk_v<U> || is_binary_array_view_v<U> || is_basic_string_v<U>) {
+				return true;
+			} else if constexpr (is_reflected_v<U>) {
+				return is_reflected_readable<U>(std::make_index_sequence<visit_struct::context<ImContext>::field_count<U>()>{});
+			} else if constexpr (is_bulk_array_v<U>) {
+				return std::is_default_constructible_v<range_value_t<U>>; /* resized before the copy */
+			} else if constexpr (is_map_like_v<U>) {
+				return is_binary_creatable<typename U::key_type>() && is_binary_creatable<typename U::mapped_type>();
+			} else if constexpr (is_fixed_range_v<U>) {
+				return is_binary_readable<range_value_t<U>>();
+			} else if constexpr (is_range_v<U>) {
+				if constexpr (has_emplace_back_v<U>) {
+					/* std::vector<bool> hands out proxies */
+					return std::is_lvalue_reference_v<decltype(std::declval<U&>().emplace_back())> && is_binary_creatable<range_value_t<U>>();
+				} else {
+					return is_binary_creatable<range_value_t<U>>();
+				}
+			} else if constexpr (is_tuple_like_v<U>) {
+				return is_tuple_readable<U>(std::make_index_sequence<std::tuple_size_v<U>>{});
+			} else if constexpr (is_optional_v<U>) {
+				return is_binary_creatable<typename U::value_type>();
+			} else if constexpr (is_variant_v<U>) {
+				return is_variant_readable<U>(std::make_index_sequence<std::variant_size_v<U>>{});
+			} else if constexpr (is_smart_pointer_v<U>) {
+				if constexpr (std::is_same_v<U, std::weak_ptr<typename U::element_type>>) return true;
+				else return is_binary_readable<typename U::element_type>();
+			} else {
+				return true; /* values without data */
+			}
+		}
+
+		template<typename T>
+		constexpr bool is_binary_readable_v = is_binary_readable<T>();
+
+		/* FNV-1a, the schema is hashed while it is walked */
+		inline void schema_mix(std::uint64_t& hash, std::string_view text) {
+			for (const char c : text) {
+				hash ^= static_cast<unsigned char>(c);
+				hash *= 1099511628211ull;
+			}
+		}
+
+		inline void schema_mix(std::uint64_t& hash, std::size_t value) {
+			char buffer[24];
+			const auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+			schema_mix(hash, std::string_view(buffer, static_cast<std::size_t>(result.ptr - buffer)));
+		}
+
+		template<typename T>
+		void schema_of(std::uint64_t& hash);
+
+		template<typename T, std::size_t... I>
+		void schema_of_reflected(std::uint64_t& hash, std::index_sequence<I...>) {
+			using ctx = visit_struct::context<ImContext>;
+			((schema_mix(hash, ctx::get_name<static_cast<int>(I), T>()), schema_mix(hash, ":"), schema_of<ctx::type_at<static_cast<int>(I), T>>(hash), schema_mix(hash, ";")), ...);
+		}
+
+		template<typename T, std::size_t... I>
+		void schema_of_tuple(std::uint64_t& hash, std::index_sequence<I...>) {
+			(schema_of<std::tuple_element_t<I, T>>(hash), ...);
+		}
+
+		template<typename T, std::size_t... I>
+		void schema_of_variant(std::uint64_t& hash, std::index_sequence<I...>) {
+			(schema_of<std::variant_alternative_t<I, T>>(hash), ...);
+		}
+
+		template<typename T>
+		void schema_of(std::uint64_t& hash) {
+			using U = std::remove_cv_t<T>;
+			if constexpr (is_binary_array_view_v<U>) {
+				schema_of<std::vector<std::remove_cv_t<typename U::value_type>>>(hash);
+			} else if constexpr (has_binary_write_v<U>) {
+				/* Custom encoding, only the size is known */
+				schema_mix(hash, "c");
+				schema_mix(hash, sizeof(U));
+			} else if constexpr (is_reflected_v<U>) {
+				schema_mix(hash, "{");
+				if constexpr (is_bulk_v<U>) schema_mix(hash, sizeof(U)); /* copied as a whole, padding included */
+				schema_of_reflected<U>(hash, std::make_index_sequence<visit_struct::context<ImContext>::field_count<U>()>{});
+				schema_mix(hash, "}");
+			} else if constexpr (std::is_same_v<U, bool>) {
+				schema_mix(hash, "b");
+			} else if constexpr (std::is_floating_point_v<U>) {
+				schema_mix(hash, "f");
+				schema_mix(hash, sizeof(U));
+			} else if constexpr (std::is_integral_v<U>) {
+				schema_mix(hash, std::is_signed_v<U> ? "i" : "u");
+				schema_mix(hash, sizeof(U));
+			} else if constexpr (std::is_enum_v<U>) {
+				schema_mix(hash, "e");
+				schema_mix(hash, sizeof(U));
+			} else if constexpr (is_basic_string_v<U>) {
+				schema_mix(hash, "s");
+				schema_mix(hash, sizeof(typename U::value_type));
+			} else if constexpr (is_map_like_v<U>) {
+				schema_mix(hash, "m");
+				schema_of<typename U::key_type>(hash);
+				schema_of<typename U::mapped_type>(hash);
+			} else if constexpr (is_range_v<U>) {
+				schema_mix(hash, "[");
+				schema_of<range_value_t<U>>(hash);
+				if constexpr (is_std_array_v<U>) schema_mix(hash, std::tuple_size_v<U>);
+				else if constexpr (is_c_array_v<U>) schema_mix(hash, std::extent_v<U>);
+				schema_mix(hash, "]");
+			} else if constexpr (is_tuple_like_v<U>) {
+				schema_mix(hash, "t");
+				schema_of_tuple<U>(hash, std::make_index_sequence<std::tuple_size_v<U>>{});
+			} else if constexpr (is_optional_v<U>) {
+				schema_mix(hash, "?");
+				schema_of<typename U::value_type>(hash);
+			} else if constexpr (is_variant_v<U>) {
+				schema_mix(hash, "v");
+				schema_of_variant<U>(hash, std::make_index_sequence<std::variant_size_v<U>>{});
+			} else if constexpr (is_smart_pointer_v<U>) {
+				schema_mix(hash, "*");
+				schema_of<typename U::element_type>(hash);
+			} else if constexpr (std::is_trivially_copyable_v<U>) {
+				schema_mix(hash, "x");
+				schema_mix(hash, sizeof(U));
+			} else {
+				schema_mix(hash, "-");
+			}
+		}
+
+		inline constexpr std::uint32_t binary_magic = 0x42524D49; /* "IMRB" */
+		inline constexpr std::uint32_t binary_version = 1;
+
+		struct binary_header {
+			std::uint32_t magic = binary_magic;
+			std::uint32_t version = binary_version;
+			std::uint64_t schema = 0;
+		};
+	}
+
+	/* Hash of everything that decides the layout of ``T`` in a snapshot */
+	template<typename T>
+	std::uint64_t binary_schema_hash() {
+		static const std::uint64_t hash = []() {
+			std::uint64_t result = 14695981039346656037ull;
+			Detail::schema_of<T>(result);
+			return result;
+			}();
+		return hash;
+	}
+
+	class binary_writer {
+	public:
+		explicit binary_writer(std::vector<unsigned char>& out) : _out(out), _base(out.size()) {}
+
+		void bytes(const void* data, std::size_t size) {
+			if (size == 0) return;
+			const std::size_t at = _out.size();
+			_out.resize(at + size);
+			std::memcpy(_out.data() + at, data, size);
+		}
+
+		/* Pad so the next byte sits at a multiple of ``alignment`` from the start of the snapshot */
+		void align(std::size_t alignment) {
+			const std::size_t offset = _out.size() - _base;
+			const std::size_t padding = (alignment - offset % alignment) % alignment;
+			_out.resize(_out.size() + padding, 0);
+		}
+
+		void count(std::size_t value) {
+			const std::uint64_t wide = value;
+			bytes(&wide, sizeof(wide));
+		}
+
+		template<typename T>
+		void write(const T& value);
+
+	private:
+		template<typename Tuple, std::size_t... I>
+		void write_tuple(const Tuple& value, std::index_sequence<I...>) {
+			(write(std::get<I>(value)), ...);
+		}
+
+		std::vector<unsigned char>& _out;
+		std::size_t _base; /* alignment is relative to where the snapshot starts */
+	};
+
+	class binary_reader {
+	public:
+		binary_reader(const void* data, std::size_t size)
+			: _data(static_cast<const unsigned char*>(data)), _size(size) {}
+
+		binary_result result() const { return { _error, _pos }; }
+		bool ok() const { return _error == nullptr; }
+		std::size_t remaining() const { return _size - _pos; }
+
+		bool fail(const char* error) {
+			if (_error == nullptr) _error = error;
+			return false;
+		}
+
+		bool bytes(void* out, std::size_t size) {
+			if (size > remaining()) return fail("unexpected end of snapshot");
+			if (size != 0) std::memcpy(out, _data + _pos, size);
+			_pos += size;
+			return true;
+		}
+
+		/* Point at ``size`` bytes without copying them */
+		const unsigned char* skip(std::size_t size) {
+			if (size > remaining()) {
+				fail("unexpected end of snapshot");
+				return nullptr;
+			}
+			const unsigned char* at = _data + _pos;
+			_pos += size;
+			return at;
+		}
+
+		bool align(std::size_t alignment) {
+			const std::size_t padding = (alignment - _pos % alignment) % alignment;
+			return skip(padding) != nullptr;
+		}
+
+		/* Element count, checked against what is left so a corrupt count can't allocate the world */
+		bool count(std::size_t& out, std::size_t element_size = 1) {
+			std::uint64_t wide = 0;
+			if (!bytes(&wide, sizeof(wide))) return false;
+			if (element_size != 0 && wide > remaining() / element_size) return fail("element count exceeds snapshot");
+			out = static_cast<std::size_t>(wide);
+			return true;
+		}
+
+		template<typename T>
+		bool read(T& value);
+
+	private:
+		template<typename Tuple, std::size_t... I>
+		bool read_tuple(Tuple& value, std::index_sequence<I...>) {
+			return (read(std::get<I>(value)) && ...);
+		}
+
+		template<typename Variant, std::size_t... I>
+		bool emplace_variant(Variant& value, std::size_t index, std::index_sequence<I...>) {
+			bool found = false;
+			((index == I && !found ? (found = true, read(value.template emplace<I>())) : false), ...);
+			return found ? ok() : fail("variant index out of range");
+		}
+
+		template<typename Range>
+		bool read_range(Range& value);
+
+		const unsigned char* _data;
+		std::size_t _size;
+		std::size_t _pos = 0;
+		const char* _error = nullptr;
+	};
+
+	template<typename T>
+	void binary_writer::write(const T& value) {
+		using U = std::remove_cv_t<T>;
+		if constexpr (Detail::has_binary_write_v<U>) {
+			tag_invoke(binary_write, *this, value);
+		} else if constexpr (Detail::is_bulk_v<U>) {
+			bytes(&value, sizeof(U));
+		} else if constexpr (Detail::is_binary_array_view_v<U>) {
+			count(value.size);
+			align(alignof(typename U::value_type));
+			bytes(value.data, value.size * sizeof(typename U::value_type));
+		} else if constexpr (Detail::is_reflected_v<U>) {
+			visit_struct::context<Detail::ImContext>::for_each(value,
+				[&](const char*, const auto& field) { write(field); });
+		} else if constexpr (Detail::is_basic_string_v<U>) {
+			count(value.size());
+			bytes(value.data(), value.size() * sizeof(typename U::value_type));
+		} else if constexpr (Detail::is_bulk_array_v<U>) {
+			/* One memcpy for the whole array, aligned so it can be viewed in place */
+			count(value.size());
+			align(alignof(typename U::value_type));
+			bytes(value.data(), value.size() * sizeof(typename U::value_type));
+		} else if constexpr (Detail::is_map_like_v<U>) {
+			count(value.size());
+			for (const auto& [k, v] : value) {
+				write(k);
+				write(v);
+			}
+		} else if constexpr (Detail::is_range_v<U>) {
+			count(Detail::range_size(value));
+			for (const auto& element : value) write(element);
+		} else if constexpr (Detail::is_tuple_like_v<U>) {
+			write_tuple(value, std::make_index_sequence<std::tuple_size_v<U>>{});
+		} else if constexpr (Detail::is_optional_v<U>) {
+			write(value.has_value());
+			if (value.has_value()) write(*value);
+		} else if constexpr (Detail::is_variant_v<U>) {
+			const std::uint32_t index = value.valueless_by_exception() ? UINT32_MAX : static_cast<std::uint32_t>(value.index());
+			write(index);
+			if (index != UINT32_MAX) std::visit([&](const auto& alternative) { write(alternative); }, value);
+		} else if constexpr (Detail::is_smart_pointer_v<U>) {
+			/* weak pointers don't own their value, they are saved as empty */
+			if constexpr (std::is_same_v<U, std::weak_ptr<typename U::element_type>>) {
+				write(false);
+			} else {
+				write(static_cast<bool>(value));
+				if (value) write(*value);
+			}
+		} else {
+			/* std::function and other values without data */
+		}
+	}
+
+	template<typename Range>
+	bool binary_reader::read_range(Range& value) {
+		using V = Detail::range_value_t<Range>;
+		if constexpr (Detail::is_bulk_array_v<Range>) {
+			std::size_t size = 0;
+			if (!count(size, sizeof(V)) || !align(alignof(V))) return false;
+			if (size > remaining() / sizeof(V)) return fail("element count exceeds snapshot");
+			value.resize(size);
+			return bytes(value.data(), size * sizeof(V));
+		} else if constexpr (Detail::is_map_like_v<Range>) {
+			using K = typename Range::key_type;
+			using M = typename Range::mapped_type;
+			std::size_t size = 0;
+			if (!count(size)) return false;
+			value.clear();
+			for (std::size_t i = 0; i < size; ++i) {
+				K key{};
+				M mapped{};
+				if (!read(key) || !read(mapped)) return false;
+				value.emplace(std::move(key), std::move(mapped));
+			}
+			return true;
+		} else if constexpr (Detail::is_fixed_range_v<Range>) {
+			std::size_t size = 0;
+			if (!count(size, 0)) return false;
+			if (size != Detail::range_size(value)) return fail("array size mismatch");
+			for (auto& element : value) {
+				if (!read(element)) return false;
+			}
+			return true;
+		} else {
+			std::size_t size = 0;
+			if (!count(size)) return false;
+			value.clear();
+			if constexpr (Detail::has_emplace_back_v<Range>) {
+				for (std::size_t i = 0; i < size; ++i) {
+					if (!read(value.emplace_back())) return false;
+				}
+			} else if constexpr (Detail::has_emplace_after_v<Range>) {
+				auto last = value.before_begin();
+				for (std::size_t i = 0; i < size; ++i) {
+					last = value.emplace_after(last);
+					if (!read(*last)) return false;
+				}
+			} else {
+				/* Sets: elements are const once inserted */
+				for (std::size_t i = 0; i < size; ++i) {
+					V element{};
+					if (!read(element)) return false;
+					value.insert(std::move(element));
+				}
+			}
+			return true;
+		}
+	}
+	template<typename T>
+	bool binary_reader::read(T& value) {
+		if (!ok()) return false;
+		using U = std::remove_cv_t<T>;
+		static_assert(!std::is_const_v<T>, "ImReflect Error: can't read a snapshot into a const value");
+
+		if constexpr (Detail::has_binary_read_v<U>) {
+			tag_invoke(binary_read, *this, value);
+			return ok();
+		} else if constexpr (Detail::is_bulk_v<U>) {
+			return bytes(&value, sizeof(U));
+		} else if constexpr (Detail::is_binary_array_view_v<U>) {
+			using V = typename U::value_type;
+			std::size_t size = 0;
+			if (!count(size, sizeof(V)) || !align(alignof(V))) return false;
+			if (size > remaining() / sizeof(V)) return fail("element count exceeds snapshot");
+			const unsigned char* at = _data + _pos;
+			if (reinterpret_cast<std::uintptr_t>(at) % alignof(V) != 0) return fail("snapshot buffer is not aligned for in place views");
+			value.data = reinterpret_cast<const V*>(skip(size * sizeof(V)));
+			value.size = size;
+			return ok();
+		} else if constexpr (Detail::is_reflected_v<U>) {
+			visit_struct::context<Detail::ImContext>::for_each(value,
+				[&](const char*, auto& field) {
+					if constexpr (!std::is_const_v<std::remove_reference_t<decltype(field)>>) {
+						read(field);
+					} else {
+						/* Still has to be consumed */
+						std::remove_cv_t<std::remove_reference_t<decltype(field)>> ignored{};
+						read(ignored);
+					}
+				});
+			return ok();
+		} else if constexpr (Detail::is_basic_string_v<U>) {
+			using C = typename U::value_type;
+			std::size_t size = 0;
+			if (!count(size, sizeof(C))) return false;
+			value.resize(size);
+			return bytes(value.data(), size * sizeof(C));
+		} else if constexpr (Detail::is_range_v<U>) {
+			return read_range(value);
+		} else if constexpr (Detail::is_tuple_like_v<U>) {
+			return read_tuple(value, std::make_index_sequence<std::tuple_size_v<U>>{});
+		} else if constexpr (Detail::is_optional_v<U>) {
+			bool has_value = false;
+			if (!read(has_value)) return false;
+			if (!has_value) {
+				value.reset();
+				return true;
+			}
+			return read(value.emplace());
+		} else if constexpr (Detail::is_variant_v<U>) {
+			std::uint32_t index = 0;
+			if (!read(index)) return false;
+			if (index == UINT32_MAX) return true; /* was valueless, keep the current value */
+			return emplace_variant(value, index, std::make_index_sequence<std::variant_size_v<U>>{});
+		} else if constexpr (Detail::is_smart_pointer_v<U>) {
+			using E = typename U::element_type;
+			bool has_value = false;
+			if (!read(has_value)) return false;
+			if constexpr (std::is_same_v<U, std::weak_ptr<E>>) {
+				return true;
+			} else {
+				if (!has_value) {
+					value.reset();
+					return true;
+				}
+				if (!value) {
+					if constexpr (std::is_default_constructible_v<E>) {
+						if constexpr (std::is_same_v<U, std::shared_ptr<E>>) value = std::make_shared<E>();
+						else value = std::make_unique<E>();
+					} else {
+						return fail("can't create pointee, type is not default constructible");
+					}
+				}
+				return read(*value);
+			}
+		} else {
+			return true;
+		}
+	}
+
+	/* Read-only view of a whole file, mapped into memory */
+	class mapped_file {
+	public:
+		mapped_file() = default;
+		explicit mapped_file(const char* path) { open(path); }
+		~mapped_file() { close(); }
+
+		mapped_file(const mapped_file&) = delete;
+		mapped_file& operator=(const mapped_file&) = delete;
+
+		bool open(const char* path) {
+			close();
+#ifdef _WIN32
+			_file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+			if (_file == INVALID_HANDLE_VALUE) return false;
+			LARGE_INTEGER size{};
+			if (!GetFileSizeEx(_file, &size) || size.QuadPart == 0) {
+				close();
+				return false;
+			}
+			_mapping = CreateFileMappingA(_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+			if (_mapping == nullptr) {
+				close();
+				return false;
+			}
+			_data = MapViewOfFile(_mapping, FILE_MAP_READ, 0, 0, 0);
+			if (_data == nullptr) {
+				close();
+				return false;
+			}
+			_size = static_cast<std::size_t>(size.QuadPart);
+#else
+			_fd = ::open(path, O_RDONLY);
+			if (_fd < 0) return false;
+			struct stat info {};
+			if (fstat(_fd, &info) != 0 || info.st_size <= 0) {
+				close();
+				return false;
+			}
+			void* data = mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, _fd, 0);
+			if (data == MAP_FAILED) {
+				close();
+				return false;
+			}
+			_data = data;
+			_size = static_cast<std::size_t>(info.st_size);
+#endif
+			return true;
+		}
+
+		void close() {
+#ifdef _WIN32
+			if (_data) UnmapViewOfFile(_data);
+			if (_mapping) CloseHandle(_mapping);
+			if (_file != INVALID_HANDLE_VALUE) CloseHandle(_file);
+			_mapping = nullptr;
+			_file = INVALID_HANDLE_VALUE;
+#else
+			if (_data) munmap(_data, _size);
+			if (_fd >= 0) ::close(_fd);
+			_fd = -1;
+#endif
+			_data = nullptr;
+			_size = 0;
+		}
+
+		bool is_open() const { return _data != nullptr; }
+		const void* data() const { return _data; }
+		std::size_t size() const { return _size; }
+
+	private:
+		void* _data = nullptr;
+		std::size_t _size = 0;
+#ifdef _WIN32
+		HANDLE _file = INVALID_HANDLE_VALUE;
+		HANDLE _mapping = nullptr;
+#else
+		int _fd = -1;
+#endif
+	};
+
+	/* Append a snapshot of ``value`` to ``out`` */
+	template<typename T>
+	void WriteBinary(const T& value, std::vector<unsigned char>& out) {
+		binary_writer writer(out);
+		Detail::binary_header header;
+		header.schema = binary_schema_hash<T>();
+		writer.bytes(&header, sizeof(header));
+		writer.write(value);
+	}
+
+	/*
+	* Read a snapshot into ``value``.
+	* ``binary_array_view`` members point into ``data``, which must outlive them.
+	*/
+	template<typename T>
+	binary_result ReadBinary(const void* data, std::size_t size, T& value) {
+		binary_reader reader(data, size);
+		Detail::binary_header header;
+		if (!reader.bytes(&header, sizeof(header))) return reader.result();
+		if (header.magic != Detail::binary_magic) {
+			reader.fail("not an ImReflect snapshot");
+		} else if (header.version != Detail::binary_version) {
+			reader.fail("unsupported snapshot version");
+		} else if (header.schema != binary_schema_hash<T>()) {
+			reader.fail("snapshot was written for a different type layout");
+		} else {
+			reader.read(value);
+		}
+		return reader.result();
+	}
+
+	template<typename T>
+	bool SaveBinary(const char* path, const T& value) {
+		std::vector<unsigned char> bytes;
+		WriteBinary(value, bytes);
+		std::FILE* file = std::fopen(path, "wb");
+		if (file == nullptr) return false;
+		const bool written = std::fwrite(bytes.data(), 1, bytes.size(), file) == bytes.size();
+		return std::fclose(file) == 0 && written;
+	}
+
+	/* Load a snapshot file through a memory mapping. The file is closed again, use ``mapped_file`` directly for array views. */
+	template<typename T>
+	binary_result LoadBinary(const char* path, T& value) {
+		mapped_file file(path);
+		if (!file.is_open()) return { "can't open file", 0 };
+		return ReadBinary(file.data(), file.size(), value);
+	}
+}
@@ -0,0 +1,123 @@
+#pragma once
+#include <imgui.h>
+
+#include "ImReflect_binary.hpp"
+#include "ImReflect_json.hpp"
+#include "ImReflect_record.hpp"
+#include "ImReflect_traits.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+/*
+* Copy/paste of values through the ImGui clipboard.
+*
+* The clipboard holds ``ImReflect/<schema hash>`` on the first line and the value as JSON after it.
+* A value only pastes onto a type with the same schema, the JSON part is readable by anything else.
+* Pasting never goes through the widgets: the text is parsed once, straight into the value.
+*/
+namespace ImReflect::Detail {
+
+	inline constexpr std::string_view clipboard_prefix = "ImReflect/";
+
+	template<typename T>
+	void append_clipboard_header(std::string& out) {
+		static constexpr char hex[] = "0123456789abcdef";
+		const std::uint64_t hash = binary_schema_hash<std::remove_cv_t<T>>();
+		out.append(clipboard_prefix.data(), clipboard_prefix.size());
+		for (int shift = 60; shift >= 0; shift -= 4) {
+			out += hex[(hash >> shift) & 0xF];
+		}
+		out += '\n';
+	}
+
+	template<typename T>
+	void clipboard_copy(const T& value) {
+		std::string text;
+		append_clipboard_header<T>(text);
+		WriteJson(value, text);
+		ImGui::SetClipboardText(text.c_str());
+	}
+
+	/* JSON part of the clipboard when it holds a ``T``, empty otherwise */
+	template<typename T>
+	std::string_view clipboard_json() {
+		const char* clipboard = ImGui::GetClipboardText();
+		if (clipboard == nullptr) return {};
+		const std::string_view text(clipboard);
+
+		std::string header;
+		append_clipboard_header<T>(header);
+		if (text.size() <= header.size() || text.compare(0, header.size(), header) != 0) return {};
+		return text.substr(header.size());
+	}
+
+	template<typename T>
+	bool clipboard_has() {
+		return !clipboard_json<T>().empty();
+	}
+
+	/* Replace ``value`` with the clipboard, it is left untouched when the clipboard doesn't parse */
+	template<typename T>
+	bool clipboard_paste(T& value) {
+		const std::string_view json = clipboard_json<T>();
+		if (json.empty()) return false;
+		if constexpr (std::is_default_constructible_v<T> && std::is_move_assignable_v<T>) {
+			T temp{};
+			if (!ReadJson(json, temp)) return false;
+			value = std::move(temp);
+			return true;
+		} else {
+			return static_cast<bool>(ReadJson(json, value));
+		}
+	}
+
+	/* Paste one element onto every element: parsed once, then copied in a single pass */
+	template<typename Container>
+	bool clipboard_paste_each(Container& container) {
+		using T = typename Container::value_type;
+		if constexpr (std::is_default_constructible_v<T> && std::is_copy_assignable_v<T>) {
+			const std::string_view json = clipboard_json<T>();
+			if (json.empty()) return false;
+			T temp{};
+			if (!ReadJson(json, temp)) return false;
+			std::fill(container.begin(), container.end(), temp);
+			return true;
+		} else {
+			return false;
+		}
+	}
+
+	/* Copy/Paste entries for a context menu that is already open, true when something was pasted */
+	template<typename T>
+	bool clipboard_menu_items(T& value, const char* copy_label = "Copy", const char* paste_label = "Paste") {
+		if (ImGui::MenuItem(copy_label)) {
+			clipboard_copy(value);
+		}
+		if constexpr (!std::is_const_v<T> && std::is_move_assignable_v<T>) {
+			if (ImGui::MenuItem(paste_label, nullptr, false, clipboard_has<T>())) {
+				scope_replace<T> replace(paste_label, value);
+				replace.capture();
+				return clipboard_paste(value);
+			}
+		} else {
+			ImGui::MenuItem(paste_label, nullptr, false, false);
+		}
+		return false;
+	}
+
+	/* Right click on a struct header */
+	template<typename T, typename TypeResponse>
+	void struct_context_menu(T& value, TypeResponse& response) {
+		if (ImGui::BeginPopupContextItem("struct_context_menu")) {
+			if (clipboard_menu_items(value)) {
+				response.changed();
+			}
+			ImGui::EndPopup();
+		}
+	}
+}
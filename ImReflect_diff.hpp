@@ -0,0 +1,454 @@
+#pragma once
+#include <imgui.h>
+
+#include "ImReflect_entry.hpp"
+#include "ImReflect_helper.hpp"
+#include "ImReflect_traits.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+/*
+* Structural diff between two instances of the same type.
+*
+* Paths look like ``transform.position[2]`` or ``lookup[some_key]``; the root has an empty path.
+* Leaves that can be printed keep their old and new value as text.
+*
+* Example:
+*	const auto diff = ImReflect::Diff(saved, live);
+*	for (const auto& change : diff) { change.path; change.kind; }
+*	ImReflect::DiffView("changes", saved, live);
+*/
+namespace ImReflect {
+
+	enum class diff_kind : std::uint8_t {
+		changed,
+		added,   /* only in b */
+		removed, /* only in a */
+	};
+
+	struct diff_change {
+		std::string_view path;
+		std::string_view a_text; /* empty when the value has no textual form */
+		std::string_view b_text;
+		diff_kind kind = diff_kind::changed;
+	};
+
+	/* All paths and values live in one string, entries are offsets into it */
+	class diff_result {
+	public:
+		struct entry {
+			std::uint32_t path_begin = 0, path_length = 0;
+			std::uint32_t a_begin = 0, a_length = 0;
+			std::uint32_t b_begin = 0, b_length = 0;
+			diff_kind kind = diff_kind::changed;
+		};
+
+		class iterator {
+		public:
+			/* Only ++, ==, != and * are provided; changes are built on dereference */
+			using iterator_category = std::forward_iterator_tag;
+			using value_type = diff_change;
+			using difference_type = std::ptrdiff_t;
+			using pointer = void;
+			using reference = diff_change;
+
+			iterator() = default;
+			iterator(const diff_result* result, std::size_t index) : _result(result), _index(index) {}
+			diff_change operator*() const { return (*_result)[_index]; }
+			iterator& operator++() { ++_index; return *this; }
+			iterator operator++(int) { iterator old = *this; ++_index; return old; }
+			bool operator==(const iterator& other) const { return _index == other._index; }
+			bool operator!=(const iterator& other) const { return _index != other._index; }
+
+		private:
+			const diff_result* _result = nullptr;
+			std::size_t _index = 0;
+		};
+
+		bool empty() const { return _entries.empty(); }
+		std::size_t size() const { return _entries.size(); }
+		void clear() { _entries.clear(); _text.clear(); }
+
+		diff_change operator[](std::size_t i) const {
+			const entry& e = _entries[i];
+			const std::string_view text(_text);
+			return { text.substr(e.path_begin, e.path_length), text.substr(e.a_begin, e.a_length), text.substr(e.b_begin, e.b_length), e.kind };
+		}
+
+		iterator begin() const { return { this, 0 }; }
+		iterator end() const { return { this, _entries.size() }; }
+
+		/* Used by the diff walk */
+		std::string& text() { return _text; }
+		void add(const entry& e) { _entries.push_back(e); }
+
+	private:
+		std::vector<entry> _entries;
+		std::string _text;
+	};
+}
+
+namespace ImReflect::Detail {
+
+	struct diff_walker {
+		diff_result& result;
+		std::string path;
+
+		/* Append a path segment, returns the length to restore */
+		std::size_t push_member(const char* name) {
+			const std::size_t length = path.size();
+			if (!path.empty()) path += '.';
+			path += name;
+			return length;
+		}
+
+		std::size_t push_index(std::size_t index) {
+			const std::size_t length = path.size();
+			path += '[';
+			append_text(path, index);
+			path += ']';
+			return length;
+		}
+
+		template<typename K>
+		std::size_t push_key(const K& key, std::size_t index) {
+			const std::size_t length = path.size();
+			path += '[';
+			if (!append_text(path, key)) {
+				path.resize(length);
+				return push_index(index);
+			}
+			path += ']';
+			return length;
+		}
+
+		void pop(std::size_t length) { path.resize(length); }
+
+		template<typename T>
+		std::uint32_t append_value(const T* value, std::uint32_t& length) {
+			std::string& text = result.text();
+			const std::size_t begin = text.size();
+			if (value) append_text(text, *value);
+			length = static_cast<std::uint32_t>(text.size() - begin);
+			return static_cast<std::uint32_t>(begin);
+		}
+
+		template<typename T>
+		void add(diff_kind kind, const T* a, const T* b) {
+			diff_result::entry e;
+			e.kind = kind;
+			std::string& text = result.text();
+			e.path_begin = static_cast<std::uint32_t>(text.size());
+			e.path_length = static_cast<std::uint32_t>(path.size());
+			text += path;
+			if constexpr (is_text_leaf_v<T>) {
+				e.a_begin = append_value(a, e.a_length);
+				e.b_begin = append_value(b, e.b_length);
+			}
+			result.add(e);
+		}
+
+		template<typename T>
+		static bool bitwise_equal(const T& a, const T& b) {
+			return std::memcmp(&a, &b, sizeof(T)) == 0;
+		}
+
+		template<typename T>
+		void walk(const T& a, const T& b) {
+			using U = std::remove_cv_t<T>;
+
+			/* Nothing to follow outside the object: equal bytes means equal everything below.
+			   Different bytes can still be equal values (padding, -0.0), those are walked. */
+			if constexpr (std::is_trivially_copyable_v<U>) {
+				if (bitwise_equal(a, b)) return;
+			}
+
+			if constexpr (is_reflected_v<U>) {
+				visit_struct::context<ImContext>::for_each(a, b,
+					[&](const char* name, const auto& field_a, const auto& field_b) {
+						const std::size_t length = push_member(name);
+						walk(field_a, field_b);
+						pop(length);
+					});
+			} else if constexpr (is_char_buffer_v<U>) {
+				/* Text up to the null, whatever follows it is not part of the value */
+				if (char_buffer_text(a) != char_buffer_text(b)) add(diff_kind::changed, &a, &b);
+			} else if constexpr (std::is_floating_point_v<U>) {
+				/* Bitwise equal NaNs are not a change */
+				if (!(a == b) && !bitwise_equal(a, b)) add(diff_kind::changed, &a, &b);
+			} else if constexpr (is_text_leaf_v<U>) {
+				if (!(a == b)) add(diff_kind::changed, &a, &b);
+			} else if constexpr (is_map_like_v<U>) {
+				walk_map(a, b);
+			} else if constexpr (is_set_like_v<U> && !allows_duplicate_keys_v<U>) {
+				walk_set(a, b);
+			} else if constexpr (is_range_v<U>) {
+				walk_range(a, b);
+			} else if constexpr (is_optional_v<U>) {
+				if (a.has_value() != b.has_value()) {
+					add<U>(a.has_value() ? diff_kind::removed : diff_kind::added, nullptr, nullptr);
+				} else if (a.has_value()) {
+					walk(*a, *b);
+				}
+			} else if constexpr (is_variant_v<U>) {
+				if (a.index() != b.index()) {
+					add<U>(diff_kind::changed, nullptr, nullptr);
+				} else if (!a.valueless_by_exception()) {
+					walk_variant(a, b, std::make_index_sequence<std::variant_size_v<U>>{});
+				}
+			} else if constexpr (is_tuple_like_v<U>) {
+				walk_tuple(a, b, std::make_index_sequence<std::tuple_size_v<U>>{});
+			} else if constexpr (is_smart_pointer_v<U>) {
+				if constexpr (std::is_same_v<U, std::weak_ptr<typename U::element_type>>) {
+					if (a.lock() != b.lock()) add<U>(diff_kind::changed, nullptr, nullptr);
+				} else {
+					if (!a || !b) {
+						if (static_cast<bool>(a) != static_cast<bool>(b)) add<U>(a ? diff_kind::removed : diff_kind::added, nullptr, nullptr);
+					} else if (a.get() != b.get()) {
+						walk(*a, *b);
+					}
+				}
+			} else if constexpr (is_equality_comparable_v<U>) {
+				if (!(a == b)) add<U>(diff_kind::changed, nullptr, nullptr);
+			}
+			/* Anything else (std::function, ...) can't be compared and is skipped */
+		}
+
+		template<typename Tuple, std::size_t... I>
+		void walk_tuple(const Tuple& a, const Tuple& b, std::index_sequence<I...>) {
+			((void)[&] {
+				const std::size_t length = push_index(I);
+				walk(std::get<I>(a), std::get<I>(b));
+				pop(length);
+			}(), ...);
+		}
+
+		/* By index, a variant may list the same type twice */
+		template<typename Variant, std::size_t... I>
+		void walk_variant(const Variant& a, const Variant& b, std::index_sequence<I...>) {
+			((a.index() == I ? walk(*std::get_if<I>(&a), *std::get_if<I>(&b)) : void()), ...);
+		}
+
+		template<typename Range>
+		void walk_range(const Range& a, const Range& b) {
+			using V = range_value_t<Range>;
+			constexpr bool is_contiguous = is_std_vector_v<Range> && !std::is_same_v<V, bool>;
+
+			auto it_a = std::begin(a);
+			auto it_b = std::begin(b);
+			const auto end_a = std::end(a);
+			const auto end_b = std::end(b);
+			std::size_t i = 0;
+
+			const auto walk_element = [&](std::size_t index, const V& element_a, const V& element_b) {
+				if constexpr (std::is_arithmetic_v<V>) {
+					/* Cheap per element test first, only build a path for actual changes */
+					if (element_a == element_b) return;
+				}
+				const std::size_t length = push_index(index);
+				walk(element_a, element_b);
+				pop(length);
+			};
+
+			if constexpr (is_contiguous && std::is_trivially_copyable_v<V>) {
+				/* Compare in chunks, memcmp is vectorized. Only chunks whose bytes differ are walked element by element. */
+				constexpr std::size_t chunk = sizeof(V) >= 256 ? 1 : 256 / sizeof(V);
+				const std::size_t common = std::min(a.size(), b.size());
+				const V* data_a = a.data();
+				const V* data_b = b.data();
+				for (std::size_t begin = 0; begin < common; begin += chunk) {
+					const std::size_t end = std::min(begin + chunk, common);
+					if (std::memcmp(data_a + begin, data_b + begin, (end - begin) * sizeof(V)) == 0) continue;
+					for (std::size_t k = begin; k < end; ++k) walk_element(k, data_a[k], data_b[k]);
+				}
+				i = common;
+				it_a += static_cast<std::ptrdiff_t>(common);
+				it_b += static_cast<std::ptrdiff_t>(common);
+			}
+
+			for (; it_a != end_a && it_b != end_b; ++it_a, ++it_b, ++i) {
+				walk_element(i, *it_a, *it_b);
+			}
+			/* Binding to const V& copies proxy references (std::vector<bool>), they have no address */
+			for (; it_a != end_a; ++it_a, ++i) {
+				const V& element = *it_a;
+				const std::size_t length = push_index(i);
+				add(diff_kind::removed, &element, static_cast<const V*>(nullptr));
+				pop(length);
+			}
+			for (; it_b != end_b; ++it_b, ++i) {
+				const V& element = *it_b;
+				const std::size_t length = push_index(i);
+				add(diff_kind::added, static_cast<const V*>(nullptr), &element);
+				pop(length);
+			}
+		}
+
+		/* Sets only differ in membership */
+		template<typename Set>
+		void walk_set(const Set& a, const Set& b) {
+			using K = typename Set::key_type;
+			std::size_t i = 0;
+			for (const auto& key : a) {
+				if (b.find(key) == b.end()) {
+					const std::size_t length = push_key(key, i);
+					add(diff_kind::removed, &key, static_cast<const K*>(nullptr));
+					pop(length);
+				}
+				++i;
+			}
+			i = 0;
+			for (const auto& key : b) {
+				if (a.find(key) == a.end()) {
+					const std::size_t length = push_key(key, i);
+					add(diff_kind::added, static_cast<const K*>(nullptr), &key);
+					pop(length);
+				}
+				++i;
+			}
+		}
+
+		/* Maps are matched by key, multimaps by position */
+		template<typename Map>
+		void walk_map(const Map& a, const Map& b) {
+			using M = typename Map::mapped_type;
+			if constexpr (allows_duplicate_keys_v<Map>) {
+				walk_range(a, b);
+			} else {
+				std::size_t i = 0;
+				for (const auto& [key, value_a] : a) {
+					const auto found = b.find(key);
+					const std::size_t length = push_key(key, i++);
+					if (found == b.end()) {
+						add(diff_kind::removed, &value_a, static_cast<const M*>(nullptr));
+					} else {
+						walk(value_a, found->second);
+					}
+					pop(length);
+				}
+				i = 0;
+				for (const auto& [key, value_b] : b) {
+					if (a.find(key) == a.end()) {
+						const std::size_t length = push_key(key, i);
+						add(diff_kind::added, static_cast<const M*>(nullptr), &value_b);
+						pop(length);
+					}
+					++i;
+				}
+			}
+		}
+	};
+}
+
+namespace ImReflect {
+
+	/* Append the differences between ``a`` and ``b`` to ``result`` */
+	template<typename T>
+	void Diff(const T& a, const T& b, diff_result& result) {
+		Detail::diff_walker walker{ result, {} };
+		walker.walk(a, b);
+	}
+
+	template<typename T>
+	diff_result Diff(const T& a, const T& b) {
+		diff_result result;
+		Diff(a, b, result);
+		return result;
+	}
+
+	namespace Detail {
+		/* Diff kept by the versioned ``DiffView`` between frames */
+		struct diff_view_cache {
+			diff_result result;
+			std::uint64_t version = 0;
+			const void* a = nullptr;
+			const void* b = nullptr;
+		};
+
+		inline std::size_t draw_diff_table(const diff_result& result, const char* a_header, const char* b_header) {
+			if (result.empty()) {
+				ImGui::TextDisabled("No differences");
+				return 0;
+			}
+
+			const ImGuiTableFlags flags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_Resizable | ImGuiTableFlags_SizingStretchProp;
+			if (ImGui::BeginTable("##diff", 3, flags)) {
+				ImGui::TableSetupColumn("Path");
+				ImGui::TableSetupColumn(a_header);
+				ImGui::TableSetupColumn(b_header);
+				ImGui::TableHeadersRow();
+
+				const ImVec4 removed_color(0.9f, 0.4f, 0.4f, 1.0f);
+				const ImVec4 added_color(0.4f, 0.9f, 0.4f, 1.0f);
+
+				ImGuiListClipper clipper;
+				clipper.Begin(static_cast<int>(result.size()));
+				while (clipper.Step()) {
+					for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row) {
+						const diff_change change = result[static_cast<std::size_t>(row)];
+						const std::string_view path = change.path.empty() ? std::string_view("(root)") : change.path;
+
+						ImGui::TableNextRow();
+						ImGui::TableSetColumnIndex(0);
+						ImGui::TextUnformatted(path.data(), path.data() + path.size());
+
+						ImGui::TableSetColumnIndex(1);
+						if (change.kind == diff_kind::added) {
+							ImGui::TextDisabled("-");
+						} else if (change.a_text.empty()) {
+							ImGui::TextColored(removed_color, change.kind == diff_kind::removed ? "removed" : "changed");
+						} else {
+							ImGui::TextUnformatted(change.a_text.data(), change.a_text.data() + change.a_text.size());
+						}
+
+						ImGui::TableSetColumnIndex(2);
+						if (change.kind == diff_kind::removed) {
+							ImGui::TextDisabled("-");
+						} else if (change.b_text.empty()) {
+							ImGui::TextColored(added_color, change.kind == diff_kind::added ? "added" : "changed");
+						} else {
+							ImGui::TextUnformatted(change.b_text.data(), change.b_text.data() + change.b_text.size());
+						}
+					}
+				}
+				ImGui::EndTable();
+			}
+			return result.size();
+		}
+	}
+
+	/*
+	* Table of differences, one row per changed path. Returns the number of differences.
+	* Walks both objects every frame, the overload taking a version only when it changes.
+	*/
+	template<typename T>
+	std::size_t DiffView(const char* label, const T& a, const T& b, const char* a_header = "A", const char* b_header = "B") {
+		const auto id = Detail::scope_id(label);
+		Detail::text_label(label);
+		return Detail::draw_diff_table(Diff(a, b), a_header, b_header);
+	}
+
+	/* Diffs again only when ``version`` changes or other objects are passed, bump it whenever ``a`` or ``b`` is edited */
+	template<typename T>
+	std::size_t DiffView(const char* label, std::uint64_t version, const T& a, const T& b, const char* a_header = "A", const char* b_header = "B") {
+		const auto id = Detail::scope_id(label);
+		Detail::text_label(label);
+
+		Detail::diff_view_cache& cache = Detail::widget_store::current().get<Detail::diff_view_cache>(ImGui::GetID("##diff_cache"));
+		if (cache.a != &a || cache.b != &b || cache.version != version) {
+			cache.result.clear();
+			Diff(a, b, cache.result);
+			cache.version = version;
+			cache.a = &a;
+			cache.b = &b;
+		}
+		return Detail::draw_diff_table(cache.result, a_header, b_header);
+	}
+}
@@ -5,9 +5,77 @@
 #include <extern/visit_struct/visit_struct.hpp>
 
 #include "ImReflect_macro.hpp"
+#include "ImReflect_traits.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <string>
 
 namespace ImReflect {
 
+	/*
+	* Per frame limit on how much of an object gets rendered.
+	* Fields are visited in declaration/container order, so the same leading subset is shown every frame
+	* and the rest is replaced by a placeholder once the budget runs out.
+	*
+	* Example:
+	*	static auto budget = ImReflect::frame_budget().max_fields(2000).max_microseconds(2000);
+	*	ImReflect::Input("world", world, settings, budget);
+	*/
+	class frame_budget {
+	public:
+		/* Maximum number of fields rendered per frame, 0 = no limit */
+		frame_budget& max_fields(std::size_t count) { _max_fields = count; return *this; }
+		/* Maximum time spent rendering per frame, 0 = no limit */
+		frame_budget& max_microseconds(std::int64_t microseconds) { _max_microseconds = microseconds; return *this; }
+
+		std::size_t get_max_fields() const { return _max_fields; }
+		std::int64_t get_max_microseconds() const { return _max_microseconds; }
+
+		/* Reset the counters, done by ``scope_budget`` */
+		void begin_frame() {
+			_rendered = 0;
+			_skipped = 0;
+			_exhausted = false;
+			_start = std::chrono::steady_clock::now();
+		}
+
+		/* Take one field from the budget, returns false once exhausted */
+		bool consume() {
+			if (_exhausted) return false;
+			if (_max_fields > 0 && _rendered >= _max_fields) {
+				_exhausted = true;
+				return false;
+			}
+			/* Reading the clock every field is measurable on huge objects, sample it */
+			if (_max_microseconds > 0 && (_rendered % 16) == 0 && elapsed_microseconds() >= _max_microseconds) {
+				_exhausted = true;
+				return false;
+			}
+			++_rendered;
+			return true;
+		}
+
+		void skip(std::size_t count) { _skipped += count; }
+
+		bool is_exhausted() const { return _exhausted; }
+		std::size_t rendered() const { return _rendered; }
+		std::size_t skipped() const { return _skipped; }
+		std::int64_t elapsed_microseconds() const {
+			return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - _start).count();
+		}
+
+	private:
+		std::size_t _max_fields = 0;
+		std::int64_t _max_microseconds = 0;
+
+		std::size_t _rendered = 0;
+		std::size_t _skipped = 0;
+		bool _exhausted = false;
+		std::chrono::steady_clock::time_point _start = std::chrono::steady_clock::now();
+	};
+
 	/* Forward declare */
 	namespace Detail {
 		template<typename T>
@@ -47,24 +115,158 @@ namespace ImReflect {
 			svh::is_tag_invocable_v<ImInputLib_t, const char*, T&, ImSettings&, ImResponse&> ||
 			visit_struct::traits::is_visitable<std::remove_cv_t<T>, ImContext>::value;
 
+		/* Unique address per type, used to tell a struct apart from its first member */
+		template<typename T>
+		struct type_tag {
+			static constexpr char id = 0;
+		};
+
+		template<typename T>
+		const void* type_tag_of() {
+			return &type_tag<std::remove_cv_t<T>>::id;
+		}
+
+		/* Field filter consulted while rendering, see ImReflect::search_index */
+		struct field_filter {
+			virtual ~field_filter() = default;
+			virtual bool is_visible(const void* address, const void* type) const = 0;
+		};
+
+		inline field_filter*& active_field_filter() {
+			static thread_local field_filter* filter = nullptr;
+			return filter;
+		}
+
+		template<typename T>
+		bool is_field_visible(const T& value) {
+			const field_filter* filter = active_field_filter();
+			return filter == nullptr || filter->is_visible(&value, type_tag_of<T>());
+		}
+
+		/* Budget consulted while rendering, see ImReflect::frame_budget */
+		inline frame_budget*& active_budget() {
+			static thread_local frame_budget* budget = nullptr;
+			return budget;
+		}
+
+		inline bool consume_budget() {
+			frame_budget* budget = active_budget();
+			return budget == nullptr || budget->consume();
+		}
+
+		/* Stand-in for fields cut by the frame budget, ``skipped`` = 0 when unknown */
+		inline void budget_placeholder(std::size_t skipped) {
+			if (frame_budget* budget = active_budget()) {
+				budget->skip(skipped);
+			}
+			if (skipped > 0) {
+				ImGui::TextDisabled("... %zu more", skipped);
+			} else {
+				ImGui::TextDisabled("...");
+			}
+			if (ImGui::IsItemHovered(ImGuiHoveredFlags_AllowWhenDisabled)) {
+				ImGui::SetTooltip("Not rendered this frame, frame budget exhausted");
+			}
+		}
+
+		/* Type erased copy of a leaf value, see ImReflect::undo_journal */
+		struct journal_codec {
+			std::size_t(*size)(const void* value);
+			void(*save)(const void* value, unsigned char* out);
+			void(*load)(void* value, const unsigned char* data, std::size_t size);
+		};
+
+		/* Leaves whose edits are recorded: primitives, strings and trivially copyable user widgets */
+		template<typename T>
+		constexpr bool is_journaled_v = !std::is_const_v<T> && (
+			std::is_arithmetic_v<T> || std::is_enum_v<T> || std::is_same_v<T, std::string> ||
+			(std::is_trivially_copyable_v<T> && svh::is_tag_invocable_v<ImInput_t, const char*, T&, ImSettings&, ImResponse&>));
+
+		template<typename T>
+		const journal_codec& journal_codec_of() {
+			if constexpr (std::is_same_v<T, std::string>) {
+				static const journal_codec codec{
+					[](const void* value) { return static_cast<const std::string*>(value)->size(); },
+					[](const void* value, unsigned char* out) {
+						const auto& str = *static_cast<const std::string*>(value);
+						std::memcpy(out, str.data(), str.size());
+					},
+					[](void* value, const unsigned char* data, std::size_t size) {
+						static_cast<std::string*>(value)->assign(reinterpret_cast<const char*>(data), size);
+					}
+				};
+				return codec;
+			} else {
+				static const journal_codec codec{
+					[](const void*) { return sizeof(T); },
+					[](const void* value, unsigned char* out) { std::memcpy(out, value, sizeof(T)); },
+					[](void* value, const unsigned char* data, std::size_t) { std::memcpy(value, data, sizeof(T)); }
+				};
+				return codec;
+			}
+		}
+
+		struct edit_journal {
+			virtual ~edit_journal() = default;
+			/*
+			* Called right after a journaled leaf widget ran.
+			* ``before`` is the value from before the widget or nullptr (strings), then the current value is used.
+			*/
+			virtual void on_leaf(const char* label, void* address, const journal_codec& codec, const void* before, bool changed, bool active, bool finished) = 0;
+			/*
+			* Called once a widget changed a value as a whole: insert, erase, reorder, bulk operation, paste.
+			* ``type`` is ``type_tag_of<T>()``, ``before`` the old value saved with ``codec``.
+			* ``codec`` is nullptr when the type can't be saved, paths below ``address`` may lead elsewhere now.
+			*/
+			virtual void on_replace(const char* label, void* address, const void* type, const journal_codec* codec, const unsigned char* before, std::size_t before_size) = 0;
+			/* True once for a value the journal wrote since it was last drawn (undo, redo), its widget reports the change */
+			virtual bool take_applied(const void* address, const void* type) = 0;
+		};
+
+		inline edit_journal*& active_journal() {
+			static thread_local edit_journal* journal = nullptr;
+			return journal;
+		}
+
+		/* For widgets drawn on temporary copies, the journal must not keep their address */
+		struct scope_suspend_journal {
+			edit_journal* const previous;
+			scope_suspend_journal() : previous(active_journal()) { active_journal() = nullptr; }
+			~scope_suspend_journal() { active_journal() = previous; }
+		};
+
 		/* Forward declare */
 		template<typename T>
 		void InputImpl(const char* label, T& value, ImSettings& settings, ImResponse& response);
 
-		template<typename T>
-		void imgui_input_visit_field(const char* label, T& value, ImSettings& settings, ImResponse& response) {
+		/* Defined in ImReflect_clipboard.hpp */
+		template<typename T, typename TypeResponse>
+		void struct_context_menu(T& value, TypeResponse& response);
+
+		template<typename T, typename TypeResponse>
+		void imgui_input_visit_field(const char* label, T& value, ImSettings& settings, TypeResponse& response) {
 			constexpr bool is_const = std::is_const_v<T>;
 			ImGui::PushID(label);
 			const bool empty = std::string(label).empty();
-			if (!empty) ImGui::SeparatorText(label);
+			if (!empty) {
+				ImGui::SeparatorText(label);
+				struct_context_menu(value, response);
+			}
 			if constexpr (is_const) {
 				if (ImGui::IsItemHovered(ImGuiHoveredFlags_AllowWhenDisabled)) {
 					ImGui::SetTooltip("Const object");
 				}
 			}
 			if (!empty) ImGui::Indent();
+			std::size_t skipped = 0;
 			visit_struct::context<ImContext>::for_each(value,
 				[&](const char* name, auto& field) {
+					if (!is_field_visible(field)) return;
+					if (skipped > 0 || !consume_budget()) {
+						++skipped;
+						return;
+					}
+
 					auto& member_settings = settings.get_member(value, field);
 					auto& member_response = response.get_member(value, field);
 
@@ -74,10 +276,35 @@ namespace ImReflect {
 					InputImpl(label.c_str(), field, member_settings, member_response); // recurse
 					ImGui::PopID();
 				});
+			if (skipped > 0) budget_placeholder(skipped);
 			if (!empty) ImGui::Unindent();
 			ImGui::PopID();
 		}
 
+		/* Pick the implementation for T, settings/response are already resolved for T */
+		template<typename T, typename TypeSettings, typename TypeResponse>
+		void input_dispatch(const char* label, T& value, TypeSettings& type_settings, TypeResponse& type_response) {
+			/* Try tag_invoke for user defined implementations */
+			if constexpr (svh::is_tag_invocable_v<ImInput_t, const char*, T&, ImSettings&, ImResponse&>) {
+				tag_invoke(input, label, value, type_settings, type_response);
+			}
+			/* If type is reflected */
+			else if constexpr (visit_struct::traits::is_visitable<std::remove_cv_t<T>, ImContext>::value) {
+				imgui_input_visit_field(label, value, type_settings, type_response);
+			}
+			/* Try tag_invoke with default library implementations */
+			else if constexpr (svh::is_tag_invocable_v<ImInputLib_t, const char*, T&, ImSettings&, ImResponse&>) {
+				tag_invoke(input_lib, label, value, type_settings, type_response);
+			} else {
+				//TODO: add link to documentation
+				static_assert(svh::always_false<T>::value, "ImReflect Error: No suitable Input implementation found for type T");
+			}
+		}
+
+		/* Defined in ImReflect_helper.hpp */
+		template<typename T, typename TypeSettings, typename TypeResponse>
+		void deferred_input(const char* label, T& value, TypeSettings& type_settings, TypeResponse& type_response);
+
 		template<typename T>
 		void InputImpl(const char* label, T& value, ImSettings& settings, ImResponse& response) {
 			auto& type_settings = settings.get<T>();
@@ -100,20 +327,44 @@ namespace ImReflect {
 				ImGui::PushItemWidth(min_width);
 			}
 
-			/* Try tag_invoke for user defined implementations */
-			if constexpr (svh::is_tag_invocable_v<ImInput_t, const char*, T&, ImSettings&, ImResponse&>) {
-				tag_invoke(input, label, value, type_settings, type_response);
-			}
-			/* If type is reflected */
-			else if constexpr (visit_struct::traits::is_visitable<std::remove_cv_t<T>, ImContext>::value) {
-				imgui_input_visit_field(label, value, type_settings, type_response);
+			const std::size_t change_count = type_response.change_count();
+			const std::size_t commit_count = type_response.commit_count();
+
+			/* Trivially copyable leaves are copied up front, some widgets edit on the frame they activate */
+			edit_journal* const journal = active_journal();
+			std::conditional_t<is_journaled_v<T> && !std::is_same_v<T, std::string>, std::remove_const_t<T>, char> journal_before{};
+			if constexpr (is_journaled_v<T> && !std::is_same_v<T, std::string>) {
+				if (journal) journal_before = value;
 			}
-			/* Try tag_invoke with default library implementations */
-			else if constexpr (svh::is_tag_invocable_v<ImInputLib_t, const char*, T&, ImSettings&, ImResponse&>) {
-				tag_invoke(input_lib, label, value, type_settings, type_response);
+
+			/* Edit a shadow copy, written back once the edit gesture ends */
+			if constexpr (!std::is_const_v<T> && is_deep_copyable_v<T>) {
+				if (type_settings.is_deferred_commit()) {
+					deferred_input(label, value, type_settings, type_response);
+				} else {
+					input_dispatch(label, value, type_settings, type_response);
+				}
 			} else {
-				//TODO: add link to documentation
-				static_assert(svh::always_false<T>::value, "ImReflect Error: No suitable Input implementation found for type T");
+				input_dispatch(label, value, type_settings, type_response);
+			}
+
+			if constexpr (is_journaled_v<T>) {
+				if (journal) {
+					const void* before = nullptr;
+					if constexpr (!std::is_same_v<T, std::string>) before = &journal_before;
+					journal->on_leaf(label, &value, journal_codec_of<T>(), before,
+						type_response.change_count() != change_count,
+						ImGui::IsItemActive(), ImGui::IsItemDeactivatedAfterEdit());
+				}
+			}
+			if constexpr (!std::is_const_v<T>) {
+				if (journal && journal->take_applied(&value, type_tag_of<T>())) type_response.changed();
+			}
+
+			if (type_settings.has_callbacks()) {
+				type_settings.invoke_callbacks(value,
+					type_response.change_count() != change_count,
+					type_response.commit_count() != commit_count);
 			}
 
 			if (disabled) {
@@ -128,8 +379,16 @@ namespace ImReflect {
 		}
 	}
 
+	namespace Detail {
+		/* Pointers go to the pointer inputs, everything else (C arrays included) binds by reference */
+		template<typename T>
+		using enable_if_not_pointer_t = std::enable_if_t<!std::is_pointer_v<std::remove_reference_t<T>>, int>;
+		template<typename T>
+		using enable_if_pointer_t = std::enable_if_t<std::is_pointer_v<std::remove_reference_t<T>>, int>;
+	}
+
 	/* Public entry points */
-	template<typename T>
+	template<typename T, Detail::enable_if_not_pointer_t<T> = 0>
 	ImResponse Input(const char* label, T& value) {
 		ImSettings settings;
 		ImResponse response;
@@ -138,7 +397,7 @@ namespace ImReflect {
 	}
 
 	/* With settings */
-	template<typename T>
+	template<typename T, Detail::enable_if_not_pointer_t<T> = 0>
 	ImResponse Input(const char* label, T& value, ImSettings& settings) {
 		ImResponse response;
 		Detail::InputImpl(label, value, settings, response);
@@ -146,15 +405,40 @@ namespace ImReflect {
 	}
 
 	/* Genreally not needed by users, mainly gets called by other input implementations */
-	template<typename T>
+	template<typename T, Detail::enable_if_not_pointer_t<T> = 0>
 	void Input(const char* label, T& value, ImSettings& settings, ImResponse& response) {
 		Detail::InputImpl(label, value, settings, response);
 	}
 
+	/* While alive, rendering stops once ``budget`` is exhausted. Starts a new budget frame. */
+	struct scope_budget {
+		frame_budget* const previous;
+		scope_budget(frame_budget& budget) : previous(Detail::active_budget()) {
+			budget.begin_frame();
+			Detail::active_budget() = &budget;
+		}
+		~scope_budget() { Detail::active_budget() = previous; }
+	};
 
-	/* Pointer inputs */
-	template<typename T>
-	ImResponse Input(const char* label, T* value) {
+	/* Budgeted inputs, render a stable leading subset of ``value`` */
+	template<typename T, Detail::enable_if_not_pointer_t<T> = 0>
+	ImResponse Input(const char* label, T& value, ImSettings& settings, frame_budget& budget) {
+		const scope_budget scope(budget);
+		ImResponse response;
+		Detail::InputImpl(label, value, settings, response);
+		return response;
+	}
+
+	template<typename T, Detail::enable_if_not_pointer_t<T> = 0>
+	ImResponse Input(const char* label, T& value, frame_budget& budget) {
+		ImSettings settings;
+		return Input(label, value, settings, budget);
+	}
+
+
+	/* Pointer inputs, taken as forwarding references so C arrays don't decay into them */
+	template<typename P, Detail::enable_if_pointer_t<P> = 0>
+	ImResponse Input(const char* label, P&& value) {
 		if (value) {
 			return Input(label, *value);
 		} else {
@@ -170,8 +454,8 @@ namespace ImReflect {
 		}
 	}
 
-	template<typename T>
-	ImResponse Input(const char* label, T* value, ImSettings& settings) {
+	template<typename P, Detail::enable_if_pointer_t<P> = 0>
+	ImResponse Input(const char* label, P&& value, ImSettings& settings) {
 		if (value) {
 			return Input(label, *value, settings);
 		} else {
@@ -186,8 +470,8 @@ namespace ImReflect {
 		}
 	}
 
-	template<typename T>
-	ImResponse Input(const char* label, T* value, ImSettings& settings, ImResponse& response) {
+	template<typename P, Detail::enable_if_pointer_t<P> = 0>
+	ImResponse Input(const char* label, P&& value, ImSettings& settings, ImResponse& response) {
 		if (value) {
 			Detail::InputImpl(label, *value, settings, response);
 		} else {
@@ -2,6 +2,20 @@
 #include <imgui.h>
 #include <imgui_internal.h>
 #include "ImReflect_entry.hpp"
+#include "ImReflect_record.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
 
 /* Usefull helper functions */
 namespace ImReflect::Detail {
@@ -134,9 +148,97 @@ namespace ImReflect::Detail {
 		bool has_label() const { return !_label.empty(); }
 	};
 
+	/* Edit a shadow copy and only write it to the value once the edit is finished */
+	template<typename T>
+	struct deferred_commit_mixin {
+	private:
+		bool _deferred_commit = false;
+	public:
+		type_settings<T>& deferred_commit(const bool v = true) { _deferred_commit = v; RETURN_THIS; }
+		bool is_deferred_commit() const { return _deferred_commit; }
+	};
+
+	/*
+	* Callbacks invoked from the widget path, instead of polling the response.
+	* Callbacks take no arguments, ``T&`` or ``const T&``. Tag types (``std_vector``, ...) cover many value
+	* types, name the one the callback takes: ``on_change<std::vector<int>>([](std::vector<int>& v) {})``.
+	* A typed callback only runs for values of that type, and for const values only if it takes ``const V&``.
+	*/
+	template<typename T>
+	struct change_callbacks_mixin {
+	private:
+		struct callback {
+			bool on_commit = false;
+			const void* type = nullptr; /* ``type_tag_of<V>()``, null when the callback takes no arguments */
+			std::function<void(void*)> invoke;
+			std::function<void(const void*)> invoke_const; /* empty when the callback needs a mutable value */
+		};
+		std::vector<callback> _callbacks; /* one flat table, checked once per widget */
+
+		template<typename V, typename F>
+		static callback wrap(bool on_commit, F&& fn) {
+			callback cb;
+			cb.on_commit = on_commit;
+			if constexpr (std::is_invocable_v<std::decay_t<F>&, V&>) {
+				cb.type = type_tag_of<V>();
+				if constexpr (std::is_invocable_v<std::decay_t<F>&, const V&>) {
+					auto shared = std::make_shared<std::decay_t<F>>(std::forward<F>(fn));
+					cb.invoke = [shared](void* value) { (*shared)(*static_cast<V*>(value)); };
+					cb.invoke_const = [shared](const void* value) { (*shared)(*static_cast<const V*>(value)); };
+				} else {
+					cb.invoke = [f = std::forward<F>(fn)](void* value) mutable { f(*static_cast<V*>(value)); };
+				}
+			} else {
+				static_assert(std::is_invocable_v<std::decay_t<F>&>, "ImReflect Error: callback must be invocable with (), (V&) or (const V&)");
+				auto shared = std::make_shared<std::decay_t<F>>(std::forward<F>(fn));
+				cb.invoke = [shared](void*) { (*shared)(); };
+				cb.invoke_const = [shared](const void*) { (*shared)(); };
+			}
+			return cb;
+		}
+
+	public:
+		/* Called every time the value changes */
+		template<typename F>
+		type_settings<T>& on_change(F&& fn) { _callbacks.push_back(wrap<T>(false, std::forward<F>(fn))); RETURN_THIS; }
+		template<typename V, typename F>
+		type_settings<T>& on_change(F&& fn) { _callbacks.push_back(wrap<V>(false, std::forward<F>(fn))); RETURN_THIS; }
+		/* Called when a deferred edit is written to the value, see ``deferred_commit()`` */
+		template<typename F>
+		type_settings<T>& on_commit(F&& fn) { _callbacks.push_back(wrap<T>(true, std::forward<F>(fn))); RETURN_THIS; }
+		template<typename V, typename F>
+		type_settings<T>& on_commit(F&& fn) { _callbacks.push_back(wrap<V>(true, std::forward<F>(fn))); RETURN_THIS; }
+		type_settings<T>& clear_callbacks() { _callbacks.clear(); RETURN_THIS; }
+
+		bool has_callbacks() const { return !_callbacks.empty(); }
+		template<typename V>
+		void invoke_callbacks(V& value, bool changed, bool committed) const {
+			const void* type = type_tag_of<V>();
+			for (const auto& cb : _callbacks) {
+				if (!(cb.on_commit ? committed : changed)) continue;
+				if (cb.type != nullptr && cb.type != type) continue;
+				if constexpr (std::is_const_v<V>) {
+					if (cb.invoke_const) cb.invoke_const(&value);
+				} else {
+					cb.invoke(&value);
+				}
+			}
+		}
+	};
+
+	/* Bumped whenever the settings are changed from outside the code, e.g. by a reloaded preset */
+	template<typename T>
+	struct generation_mixin {
+	private:
+		std::uint32_t _generation = 0;
+	public:
+		type_settings<T>& bump_generation() { ++_generation; RETURN_THIS; }
+		std::uint32_t generation() const { return _generation; }
+	};
+
 	/* Required marker */
 	template<typename T>
-	struct required : disabled<T>, min_width_mixin<T>, same_line_mixin<T>, separator_mixin<T>, label_mixin<T> {
+	struct required : disabled<T>, min_width_mixin<T>, same_line_mixin<T>, separator_mixin<T>, label_mixin<T>, deferred_commit_mixin<T>, change_callbacks_mixin<T>, generation_mixin<T> {
 
 	};
 
@@ -193,6 +295,7 @@ namespace ImReflect::Detail {
 		virtual void clicked(ImGuiMouseButton button) = 0;
 		virtual void double_clicked(ImGuiMouseButton button) = 0;
 		virtual void focused() = 0;
+		virtual void committed() = 0;
 	};
 
 	template<typename T>
@@ -207,6 +310,9 @@ namespace ImReflect::Detail {
 		bool _is_clicked[Internal::mouse_button_count] = { false };
 		bool _is_double_clicked[Internal::mouse_button_count] = { false };
 		bool _is_focused = false;
+		bool _is_committed = false;
+		std::size_t _change_count = 0;
+		std::size_t _commit_count = 0;
 
 		/* Helper to chain calls to parent */
 		template<typename Method, typename... Args>
@@ -223,6 +329,7 @@ namespace ImReflect::Detail {
 		/* Setters */
 		void changed() override {
 			_is_changed = true;
+			++_change_count;
 			chain_to_parent(&response_base::changed);
 		}
 		void hovered() override {
@@ -261,6 +368,12 @@ namespace ImReflect::Detail {
 			_is_focused = true;
 			chain_to_parent(&response_base::focused);
 		}
+		/* A deferred edit was written to the value, see ``deferred_commit()`` */
+		void committed() override {
+			_is_committed = true;
+			++_commit_count;
+			chain_to_parent(&response_base::committed);
+		}
 
 		/* Getters */
 		bool is_changed() const { return _is_changed; }
@@ -282,5 +395,306 @@ namespace ImReflect::Detail {
 			return false;
 		}
 		bool is_focused() const { return _is_focused; }
+		bool is_committed() const { return _is_committed; }
+		/* Times changed()/committed() was set, used to tell apart items sharing a response */
+		std::size_t change_count() const { return _change_count; }
+		std::size_t commit_count() const { return _commit_count; }
+	};
+}
+
+/* Widget state that has to outlive a frame */
+namespace ImReflect::Detail {
+
+	/*
+	* One store per ImGui context, owned by the context through hooks and deleted with it.
+	* Entries are keyed by ImGuiID. At the start of every frame the entries the previous frame
+	* didn't use are dropped: closed popups, widgets that are no longer drawn.
+	* Dropped entries destroy their value but keep the allocation in a small pool per type.
+	*/
+	class widget_store {
+		struct entry_base {
+			const void* type = nullptr;
+			int last_frame = 0;
+			virtual ~entry_base() = default;
+			virtual void reset() = 0;
+		};
+
+		template<typename T>
+		struct entry : entry_base {
+			std::optional<T> value;
+			void reset() override { value.reset(); }
+		};
+
+		/* Unique address per type, no RTTI needed */
+		template<typename T>
+		static const void* type_tag() {
+			static const char tag = 0;
+			return &tag;
+		}
+
+		static constexpr ImGuiID hook_owner = 0x46524D49; /* "IMRF" */
+		static constexpr std::size_t max_pooled = 8;      /* per type */
+
+		std::unordered_map<ImGuiID, std::unique_ptr<entry_base>> _entries;
+		std::unordered_map<const void*, std::vector<std::unique_ptr<entry_base>>> _pool;
+
+		void release(std::unique_ptr<entry_base> released) {
+			released->reset();
+			auto& pool = _pool[released->type];
+			if (pool.size() < max_pooled) pool.push_back(std::move(released));
+		}
+
+	public:
+		widget_store() = default;
+		widget_store(const widget_store&) = delete;
+		widget_store& operator=(const widget_store&) = delete;
+
+		/* nullptr when there is no entry or it holds another type */
+		template<typename T>
+		T* find(ImGuiID id) {
+			const auto it = _entries.find(id);
+			if (it == _entries.end() || it->second->type != type_tag<T>()) return nullptr;
+			it->second->last_frame = ImGui::GetFrameCount();
+			return &*static_cast<entry<T>&>(*it->second).value;
+		}
+
+		template<typename T, typename... Args>
+		T& emplace(ImGuiID id, Args&&... args) {
+			std::unique_ptr<entry_base> created;
+			const auto pooled = _pool.find(type_tag<T>());
+			if (pooled != _pool.end() && !pooled->second.empty()) {
+				created = std::move(pooled->second.back());
+				pooled->second.pop_back();
+			} else {
+				created = std::make_unique<entry<T>>();
+				created->type = type_tag<T>();
+			}
+			auto& typed = static_cast<entry<T>&>(*created);
+			typed.value.emplace(std::forward<Args>(args)...);
+			typed.last_frame = ImGui::GetFrameCount();
+
+			auto& slot = _entries[id];
+			if (slot) release(std::move(slot));
+			slot = std::move(created);
+			return *typed.value;
+		}
+
+		/* The entry for ``id``, default constructed the first time */
+		template<typename T>
+		T& get(ImGuiID id) {
+			if (T* found = find<T>(id)) return *found;
+			return emplace<T>(id);
+		}
+
+		void erase(ImGuiID id) {
+			const auto it = _entries.find(id);
+			if (it == _entries.end()) return;
+			release(std::move(it->second));
+			_entries.erase(it);
+		}
+
+		std::size_t size() const { return _entries.size(); }
+
+		/* Drop what ``frame`` didn't use */
+		void collect(int frame) {
+			for (auto it = _entries.begin(); it != _entries.end();) {
+				if (it->second->last_frame != frame) {
+					release(std::move(it->second));
+					it = _entries.erase(it);
+				} else {
+					++it;
+				}
+			}
+		}
+
+		/* Store of the current context, created on first use */
+		static widget_store& current() {
+			ImGuiContext* context = ImGui::GetCurrentContext();
+			for (const ImGuiContextHook& hook : context->Hooks) {
+				if (hook.Owner == hook_owner && hook.Type == ImGuiContextHookType_Shutdown) {
+					return *static_cast<widget_store*>(hook.UserData);
+				}
+			}
+
+			widget_store* store = new widget_store();
+			ImGuiContextHook hook;
+			hook.Owner = hook_owner;
+			hook.UserData = store;
+			hook.Type = ImGuiContextHookType_NewFramePre; /* FrameCount is still the frame that ended */
+			hook.Callback = [](ImGuiContext* ctx, ImGuiContextHook* self) { static_cast<widget_store*>(self->UserData)->collect(ctx->FrameCount); };
+			ImGui::AddContextHook(context, &hook);
+			hook.Type = ImGuiContextHookType_Shutdown;
+			hook.Callback = [](ImGuiContext*, ImGuiContextHook* self) { delete static_cast<widget_store*>(self->UserData); };
+			ImGui::AddContextHook(context, &hook);
+			return *store;
+		}
+	};
+
+	/* Background work of a widget, shared between the widget and the worker running it */
+	struct async_call {
+		std::atomic<bool> done{ false };
+		std::atomic<bool> cancelled{ false };
+		std::atomic<float> progress{ -1.0f }; /* negative: unknown, draw a spinner */
+		std::string error;                    /* written before ``done`` */
+	};
+
+	/* The work running on this thread, nullptr outside of the pool */
+	inline thread_local async_call* current_async_call = nullptr;
+
+	/* Workers shared by every widget that does work in the background */
+	class async_pool {
+	public:
+		static async_pool& instance() {
+			static async_pool pool;
+			return pool;
+		}
+
+		void submit(std::function<void()> task) {
+			{
+				std::lock_guard<std::mutex> lock(_mutex);
+				_tasks.push_back(std::move(task));
+			}
+			_wake.notify_one();
+		}
+
+		bool is_stopping() const { return _stopping.load(std::memory_order_relaxed); }
+
+		~async_pool() {
+			{
+				std::lock_guard<std::mutex> lock(_mutex);
+				_stopping = true;
+				_tasks.clear();
+			}
+			_wake.notify_all();
+			for (std::thread& worker : _workers) worker.join();
+		}
+
+	private:
+		async_pool() {
+			const unsigned count = std::clamp(std::thread::hardware_concurrency(), 2u, 8u);
+			for (unsigned i = 0; i < count; ++i) _workers.emplace_back([this] { work(); });
+		}
+
+		void work() {
+			for (;;) {
+				std::function<void()> task;
+				{
+					std::unique_lock<std::mutex> lock(_mutex);
+					_wake.wait(lock, [this] { return _stopping || !_tasks.empty(); });
+					if (_stopping) return;
+					task = std::move(_tasks.front());
+					_tasks.pop_front();
+				}
+				task();
+			}
+		}
+
+		std::mutex _mutex;
+		std::condition_variable _wake;
+		std::deque<std::function<void()>> _tasks;
+		std::vector<std::thread> _workers;
+		std::atomic<bool> _stopping{ false };
+	};
+
+	/* Copy every state except changed */
+	template<typename From, typename To>
+	void forward_input_states(const From& from, To& to) {
+		if (from.is_hovered()) to.hovered();
+		if (from.is_active()) to.active();
+		if (from.is_activated()) to.activated();
+		if (from.is_deactivated()) to.deactivated();
+		if (from.is_deactivated_after_edit()) to.deactivated_after_edit();
+		for (int i = 0; i < Internal::mouse_button_count; ++i) {
+			if (from.is_clicked(i)) to.clicked(static_cast<ImGuiMouseButton>(i));
+			if (from.is_double_clicked(i)) to.double_clicked(static_cast<ImGuiMouseButton>(i));
+		}
+		if (from.is_focused()) to.focused();
+	}
+
+	template<typename T>
+	struct deferred_state {
+		T value;
+		bool dirty = false;
+		bool active = false; /* the item was active on the last frame */
 	};
-}
\ No newline at end of file
+
+	/*
+	* Render on a shadow copy while an edit is in progress. Until the item activates the live value
+	* is drawn and nothing is copied; the shadow then lives in the widget store and is written back
+	* (changed + committed) when the item is released after an edit. Widgets that edit without
+	* staying active (combos, checkboxes) commit right away. Types that aren't trivially copyable
+	* get their shadow once the item is hovered or focused, so the click or key that activates it
+	* already edits the shadow.
+	*/
+	template<typename T, typename TypeSettings, typename TypeResponse>
+	void deferred_input(const char* label, T& value, TypeSettings& type_settings, TypeResponse& type_response) {
+		auto& store = widget_store::current();
+		const ImGuiID id = ImGui::GetID(label);
+		deferred_state<T>* state = store.find<deferred_state<T>>(id);
+
+		/* Not parented, so changes stop here instead of reaching the caller */
+		TypeResponse scratch;
+
+		if (state == nullptr) {
+			if constexpr (std::is_trivially_copyable_v<T>) {
+				/* Cheap to keep, so an edit made on the frame the item activates (slider click) is held back too */
+				const T before = value;
+				input_dispatch(label, value, type_settings, scratch);
+				if (scratch.is_active() && scratch.is_changed()) {
+					store.emplace<deferred_state<T>>(id, deferred_state<T>{ value, true });
+					value = before;
+				}
+			} else {
+				/* Too big to copy every frame, only an item hovered and clicked on the same frame edits the value early */
+				input_dispatch(label, value, type_settings, scratch);
+				if (scratch.is_active() && scratch.is_changed()) {
+					store.emplace<deferred_state<T>>(id, deferred_state<T>{ value, true, true });
+				}
+			}
+			forward_input_states(scratch, type_response);
+
+			if (scratch.is_active()) {
+				if (!scratch.is_changed()) store.emplace<deferred_state<T>>(id, deferred_state<T>{ value, false, true });
+			} else if (scratch.is_changed()) {
+				type_response.changed();
+				type_response.committed();
+			} else if constexpr (!std::is_trivially_copyable_v<T>) {
+				if (scratch.is_hovered() || scratch.is_focused()) store.emplace<deferred_state<T>>(id, deferred_state<T>{ value, false });
+			}
+			return;
+		}
+
+		if constexpr (!std::is_trivially_copyable_v<T>) {
+			/* Shadow made ahead of the edit follows the live value until the item activates */
+			if (!state->dirty && !state->active) state->value = value;
+		}
+
+		{
+			const scope_suspend_journal suspend; /* the shadow lives in the widget store */
+			input_dispatch(label, state->value, type_settings, scratch);
+		}
+		forward_input_states(scratch, type_response);
+
+		const bool dirty = scratch.is_changed() || state->dirty;
+		if (dirty && (scratch.is_deactivated_after_edit() || !scratch.is_active())) {
+			/* Leaves report their own edits, anything bigger goes to the journal as one replace */
+			if constexpr (!is_journaled_v<T>) {
+				scope_replace<T> replace(label, value);
+				replace.capture();
+				value = state->value;
+			} else {
+				value = state->value;
+			}
+			type_response.changed();
+			type_response.committed();
+			store.erase(id);
+		} else if (dirty || scratch.is_active()) {
+			state->dirty = dirty;
+			state->active = scratch.is_active();
+		} else if (!std::is_trivially_copyable_v<T> && (scratch.is_hovered() || scratch.is_focused())) {
+			state->active = false;
+		} else {
+			store.erase(id);
+		}
+	}
+}
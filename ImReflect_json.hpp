@@ -0,0 +1,783 @@
+#pragma once
+#include <extern/svh/tag_invoke.hpp>
+#include <extern/magic_enum/magic_enum.hpp>
+
+#include "ImReflect_macro.hpp"
+#include "ImReflect_traits.hpp"
+
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+/*
+* JSON for everything ImReflect can display.
+*
+* The writer appends to a caller owned std::string, numbers go through to_chars.
+* The reader walks the text once and writes straight into the value, there is no DOM.
+*
+*	reflected struct      -> object, by member name (unknown keys are skipped when reading)
+*	vector, list, set...  -> array, C arrays included
+*	char[N], array<char>  -> string, up to the first null
+*	map with simple keys  -> object, other maps and multimaps -> array of [key, value]
+*	pair, tuple           -> array
+*	optional, pointers    -> null or the value
+*	variant               -> {"index": i, "value": ...}
+*	enum                  -> name, or number when the value has no name
+*
+* Custom types:
+*	void tag_invoke(ImReflect::json_write_t, ImReflect::json_writer& writer, const vec3& value);
+*	void tag_invoke(ImReflect::json_read_t, ImReflect::json_reader& reader, vec3& value);
+*
+* Example:
+*	std::string json;
+*	ImReflect::WriteJson(settings, json);
+*	if (auto result = ImReflect::ReadJson(json, settings); !result) { result.error; result.offset; }
+*/
+namespace ImReflect {
+
+	struct json_write_t {};
+	inline constexpr json_write_t json_write{};
+
+	struct json_read_t {};
+	inline constexpr json_read_t json_read{};
+
+	struct json_options {
+		int indent = 0; /* spaces per level, 0 = compact */
+	};
+
+	struct json_result {
+		const char* error = nullptr; /* nullptr on success */
+		std::size_t offset = 0;      /* where reading stopped */
+
+		explicit operator bool() const { return error == nullptr; }
+	};
+
+	class json_writer {
+	public:
+		json_writer(std::string& out, json_options options = {}) : _out(out), _options(options) {}
+
+		void begin_object() { open('{'); }
+		void end_object() { close('}'); }
+		void begin_array() { open('['); }
+		void end_array() { close(']'); }
+
+		/* Object key, the value follows with ``write`` */
+		void key(std::string_view name) {
+			separate();
+			write_string(name);
+			_out += _options.indent > 0 ? ": " : ":";
+			_after_key = true;
+		}
+
+		void null() { separate(); _out += "null"; }
+
+		void string(std::string_view text) {
+			separate();
+			write_string(text);
+		}
+
+		template<typename T>
+		void write(const T& value);
+
+	private:
+		void open(char c) {
+			separate();
+			_out += c;
+			++_depth;
+		}
+
+		void close(char c) {
+			const bool had_items = has_items();
+			--_depth;
+			if (had_items) newline();
+			_out += c;
+		}
+
+		/*
+		* Whether the innermost object/array already holds a value. Inside one the output always
+		* ends with its bracket until the first value is written, so no per level state is kept.
+		*/
+		bool has_items() const {
+			return _out.back() != '{' && _out.back() != '[';
+		}
+
+		/* Comma and indentation before a new value, unless it belongs to a key */
+		void separate() {
+			if (_after_key) {
+				_after_key = false;
+				return;
+			}
+			if (_depth == 0) return;
+			if (has_items()) _out += ',';
+			newline();
+		}
+
+		void newline() {
+			if (_options.indent <= 0) return;
+			_out += '\n';
+			_out.append(_depth * static_cast<std::size_t>(_options.indent), ' ');
+		}
+
+		void write_string(std::string_view text) {
+			static constexpr char hex[] = "0123456789abcdef";
+			_out += '"';
+			std::size_t run = 0; /* copy unescaped runs in one go */
+			for (std::size_t i = 0; i < text.size(); ++i) {
+				const unsigned char c = static_cast<unsigned char>(text[i]);
+				const char* escape = nullptr;
+				switch (c) {
+				case '"': escape = "\\\""; break;
+				case '\\': escape = "\\\\"; break;
+				case '\n': escape = "\\n"; break;
+				case '\r': escape = "\\r"; break;
+				case '\t': escape = "\\t"; break;
+				case '\b': escape = "\\b"; break;
+				case '\f': escape = "\\f"; break;
+				default: break;
+				}
+				if (escape == nullptr && c >= 0x20) continue;
+
+				_out.append(text.data() + run, i - run);
+				run = i + 1;
+				if (escape) {
+					_out += escape;
+				} else {
+					const char control[] = { '\\', 'u', '0', '0', hex[c >> 4], hex[c & 0xF] };
+					_out.append(control, sizeof(control));
+				}
+			}
+			_out.append(text.data() + run, text.size() - run);
+			_out += '"';
+		}
+
+		/* Map key, formatted like ``Detail::append_text`` without a temporary string */
+		template<typename K>
+		void write_key(const K& k) {
+			if constexpr (std::is_same_v<K, bool>) {
+				key(k ? "true" : "false");
+			} else if constexpr (std::is_same_v<K, char>) {
+				key(std::string_view(&k, 1));
+			} else if constexpr (std::is_arithmetic_v<K>) {
+				using number_t = std::conditional_t<std::is_floating_point_v<K>, K,
+					std::conditional_t<std::is_signed_v<K>, long long, unsigned long long>>;
+				char buffer[64];
+				const auto result = std::to_chars(buffer, buffer + sizeof(buffer), static_cast<number_t>(k));
+				key(std::string_view(buffer, static_cast<std::size_t>(result.ptr - buffer)));
+			} else if constexpr (std::is_enum_v<K>) {
+				const auto name = magic_enum::enum_name(k);
+				if (name.empty()) write_key(static_cast<std::underlying_type_t<K>>(k));
+				else key(name);
+			} else {
+				key(std::string_view(k.data(), k.size()));
+			}
+		}
+
+		template<typename T>
+		void write_number(T value) {
+			if constexpr (std::is_floating_point_v<T>) {
+				if (!std::isfinite(value)) {
+					_out += "null";
+					return;
+				}
+			}
+			char buffer[64];
+			const auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+			_out.append(buffer, result.ptr);
+		}
+
+		template<typename Tuple, std::size_t... I>
+		void write_tuple(const Tuple& value, std::index_sequence<I...>) {
+			begin_array();
+			(write(std::get<I>(value)), ...);
+			end_array();
+		}
+
+		std::string& _out;
+		json_options _options;
+		std::size_t _depth = 0; /* open objects/arrays */
+		bool _after_key = false;
+	};
+
+	class json_reader {
+	public:
+		explicit json_reader(std::string_view json) : _json(json) {}
+
+		json_result result() const { return { _error, _pos }; }
+		bool ok() const { return _error == nullptr; }
+
+		/* Stop reading, the first error wins */
+		bool fail(const char* error) {
+			if (_error == nullptr) _error = error;
+			return false;
+		}
+
+		/* Consume ``null`` if it is next */
+		bool read_null() {
+			skip_whitespace();
+			if (_json.compare(_pos, 4, "null") == 0) {
+				_pos += 4;
+				return true;
+			}
+			return false;
+		}
+
+		/*
+		* Read a string. The view points into the input when there are no escapes,
+		* else into a scratch buffer that is reused by the next call.
+		*/
+		bool read_string(std::string_view& out) {
+			skip_whitespace();
+			if (!consume('"')) return fail("expected string");
+
+			const std::size_t begin = _pos;
+			while (_pos < _json.size() && _json[_pos] != '"' && _json[_pos] != '\\') ++_pos;
+			if (_pos >= _json.size()) return fail("unterminated string");
+			if (_json[_pos] == '"') {
+				out = _json.substr(begin, _pos - begin);
+				++_pos;
+				return true;
+			}
+
+			_scratch.assign(_json.data() + begin, _pos - begin);
+			while (_pos < _json.size() && _json[_pos] != '"') {
+				const char c = _json[_pos++];
+				if (c != '\\') {
+					_scratch += c;
+					continue;
+				}
+				if (_pos >= _json.size()) break;
+				switch (_json[_pos++]) {
+				case '"': _scratch += '"'; break;
+				case '\\': _scratch += '\\'; break;
+				case '/': _scratch += '/'; break;
+				case 'b': _scratch += '\b'; break;
+				case 'f': _scratch += '\f'; break;
+				case 'n': _scratch += '\n'; break;
+				case 'r': _scratch += '\r'; break;
+				case 't': _scratch += '\t'; break;
+				case 'u': if (!read_unicode_escape()) return false; break;
+				default: return fail("invalid escape");
+				}
+			}
+			if (!consume('"')) return fail("unterminated string");
+			out = _scratch;
+			return true;
+		}
+
+		/* Iterate an object, ``on_key(std::string_view)`` must consume the value */
+		template<typename F>
+		bool read_object(F&& on_key) {
+			++_object_depth;
+			const bool result = read_object_members(on_key);
+			--_object_depth;
+			return result;
+		}
+
+		/* Iterate an array, ``on_element(std::size_t index)`` must consume the value */
+		template<typename F>
+		bool read_array(F&& on_element) {
+			skip_whitespace();
+			if (!consume('[')) return fail("expected array");
+			skip_whitespace();
+			if (consume(']')) return true;
+			std::size_t index = 0;
+			do {
+				if (!on_element(index++) || !ok()) return false;
+				skip_whitespace();
+			} while (consume(','));
+			if (!consume(']')) return fail("expected ']'");
+			return true;
+		}
+
+		/* Skip over any value */
+		bool skip_value() {
+			skip_whitespace();
+			if (_pos >= _json.size()) return fail("unexpected end");
+			const char c = _json[_pos];
+			if (c == '{') return read_object([&](std::string_view) { return skip_value(); });
+			if (c == '[') return read_array([&](std::size_t) { return skip_value(); });
+			if (c == '"') {
+				std::string_view ignored;
+				return read_string(ignored);
+			}
+			while (_pos < _json.size() && !is_delimiter(_json[_pos])) ++_pos;
+			return true;
+		}
+
+		template<typename T>
+		bool read(T& value);
+
+		bool at_end() {
+			skip_whitespace();
+			return _pos >= _json.size();
+		}
+
+	private:
+		static bool is_delimiter(char c) {
+			return c == ',' || c == '}' || c == ']' || c == ' ' || c == '\n' || c == '\r' || c == '\t';
+		}
+
+		void skip_whitespace() {
+			while (_pos < _json.size() && (_json[_pos] == ' ' || _json[_pos] == '\n' || _json[_pos] == '\r' || _json[_pos] == '\t')) ++_pos;
+		}
+
+		bool consume(char c) {
+			if (_pos < _json.size() && _json[_pos] == c) {
+				++_pos;
+				return true;
+			}
+			return false;
+		}
+
+		template<typename F>
+		bool read_object_members(F& on_key) {
+			skip_whitespace();
+			if (!consume('{')) return fail("expected object");
+			skip_whitespace();
+			if (consume('}')) return true;
+			do {
+				std::string_view key;
+				if (!read_string(key)) return false;
+				skip_whitespace();
+				if (!consume(':')) return fail("expected ':'");
+				/*
+				* An escaped key lives in the scratch buffer, which reading the value reuses.
+				* Move it to the buffer kept for this nesting level, the buffers swap capacity.
+				*/
+				if (!_scratch.empty() && key.data() == _scratch.data()) {
+					if (_escaped_keys.size() < _object_depth) _escaped_keys.resize(_object_depth);
+					std::string& escaped_key = _escaped_keys[_object_depth - 1];
+					escaped_key.swap(_scratch);
+					key = escaped_key;
+				}
+				if (!on_key(key) || !ok()) return false;
+				skip_whitespace();
+			} while (consume(','));
+			if (!consume('}')) return fail("expected '}'");
+			return true;
+		}
+
+		bool read_hex4(std::uint32_t& out) {
+			if (_pos + 4 > _json.size()) return fail("invalid unicode escape");
+			const auto result = std::from_chars(_json.data() + _pos, _json.data() + _pos + 4, out, 16);
+			if (result.ptr != _json.data() + _pos + 4) return fail("invalid unicode escape");
+			_pos += 4;
+			return true;
+		}
+
+		bool read_unicode_escape() {
+			std::uint32_t code = 0;
+			if (!read_hex4(code)) return false;
+			if (code >= 0xD800 && code <= 0xDBFF) {
+				std::uint32_t low = 0;
+				if (!consume('\\') || !consume('u') || !read_hex4(low) || low < 0xDC00 || low > 0xDFFF) return fail("invalid surrogate pair");
+				code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+			}
+			/* UTF-8 encode */
+			if (code < 0x80) {
+				_scratch += static_cast<char>(code);
+			} else if (code < 0x800) {
+				_scratch += static_cast<char>(0xC0 | (code >> 6));
+				_scratch += static_cast<char>(0x80 | (code & 0x3F));
+			} else if (code < 0x10000) {
+				_scratch += static_cast<char>(0xE0 | (code >> 12));
+				_scratch += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+				_scratch += static_cast<char>(0x80 | (code & 0x3F));
+			} else {
+				_scratch += static_cast<char>(0xF0 | (code >> 18));
+				_scratch += static_cast<char>(0x80 | ((code >> 12) & 0x3F));
+				_scratch += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+				_scratch += static_cast<char>(0x80 | (code & 0x3F));
+			}
+			return true;
+		}
+
+		template<typename T>
+		bool read_number(T& value) {
+			skip_whitespace();
+			const char* begin = _json.data() + _pos;
+			const char* end = _json.data() + _json.size();
+			if constexpr (std::is_floating_point_v<T>) {
+				if (read_null()) { /* written for NaN/inf */
+					value = std::numeric_limits<T>::quiet_NaN();
+					return true;
+				}
+				const auto result = std::from_chars(begin, end, value);
+				if (result.ec != std::errc()) return fail("expected number");
+				_pos += static_cast<std::size_t>(result.ptr - begin);
+			} else {
+				const auto result = std::from_chars(begin, end, value);
+				if (result.ec == std::errc::result_out_of_range) return fail("number out of range");
+				if (result.ec != std::errc()) return fail("expected integer");
+				_pos += static_cast<std::size_t>(result.ptr - begin);
+				if (_pos < _json.size() && (_json[_pos] == '.' || _json[_pos] == 'e' || _json[_pos] == 'E')) return fail("expected integer");
+			}
+			return true;
+		}
+
+		/* Map keys are strings, convert back to the key type */
+		template<typename K>
+		bool read_key(std::string_view text, K& key) {
+			using U = std::remove_cv_t<K>;
+			if constexpr (Detail::is_char_string_v<U>) {
+				key.assign(text.data(), text.size());
+				return true;
+			} else if constexpr (std::is_same_v<U, bool>) {
+				if (text == "true") key = true;
+				else if (text == "false") key = false;
+				else return fail("expected bool key");
+				return true;
+			} else if constexpr (std::is_enum_v<U>) {
+				const auto parsed = magic_enum::enum_cast<U>(text);
+				if (parsed.has_value()) {
+					key = *parsed;
+					return true;
+				}
+				std::underlying_type_t<U> underlying{};
+				const auto result = std::from_chars(text.data(), text.data() + text.size(), underlying);
+				if (result.ec != std::errc() || result.ptr != text.data() + text.size()) return fail("unknown enum key");
+				key = static_cast<U>(underlying);
+				return true;
+			} else if constexpr (std::is_same_v<U, char>) {
+				if (text.size() != 1) return fail("expected single character key");
+				key = text[0];
+				return true;
+			} else {
+				const auto result = std::from_chars(text.data(), text.data() + text.size(), key);
+				if (result.ec != std::errc() || result.ptr != text.data() + text.size()) return fail("invalid numeric key");
+				return true;
+			}
+		}
+
+		template<typename Tuple, std::size_t... I>
+		bool read_tuple(Tuple& value, std::index_sequence<I...>) {
+			return read_array([&](std::size_t index) {
+				bool handled = false;
+				((index == I ? (handled = true, read(std::get<I>(value))) : false), ...);
+				return handled ? ok() : fail("too many tuple elements");
+				});
+		}
+
+		template<typename Variant, std::size_t... I>
+		bool emplace_variant(Variant& value, std::size_t index, std::index_sequence<I...>) {
+			bool found = false;
+			((index == I && !found ? (found = true, read(value.template emplace<I>())) : false), ...);
+			return found ? ok() : fail("variant index out of range");
+		}
+
+		template<typename Range>
+		bool read_range(Range& value);
+
+		std::string_view _json;
+		std::size_t _pos = 0;
+		const char* _error = nullptr;
+		std::string _scratch; /* decoded strings with escapes */
+		std::vector<std::string> _escaped_keys; /* one per nesting level, see ``read_object`` */
+		std::size_t _object_depth = 0;
+	};
+
+	namespace Detail {
+		template<typename T>
+		constexpr bool has_json_write_v = svh::is_tag_invocable_v<json_write_t, json_writer&, const T&>;
+		template<typename T>
+		constexpr bool has_json_read_v = svh::is_tag_invocable_v<json_read_t, json_reader&, T&>;
+
+		/* Keys written as object keys, everything else makes a map an array of pairs */
+		template<typename K>
+		constexpr bool is_json_key_v = std::is_arithmetic_v<K> || std::is_enum_v<K> || is_char_string_v<K>;
+
+		template<typename T, typename = void>
+		struct is_json_object_map_impl : std::false_type {};
+		template<typename T>
+		struct is_json_object_map_impl<T, std::enable_if_t<is_map_like_v<T>>> : std::bool_constant<is_json_key_v<typename T::key_type> && !allows_duplicate_keys_v<T>> {};
+
+		/* Maps written as an object, multimaps keep duplicate keys as [key, value] pairs */
+		template<typename T>
+		constexpr bool is_json_object_map_v = is_json_object_map_impl<T>::value;
+	}
+
+	template<typename T>
+	void json_writer::write(const T& value) {
+		using U = std::remove_cv_t<T>;
+		if constexpr (Detail::has_json_write_v<U>) {
+			tag_invoke(json_write, *this, value);
+		} else if constexpr (Detail::is_reflected_v<U>) {
+			begin_object();
+			visit_struct::context<Detail::ImContext>::for_each(value,
+				[&](const char* name, const auto& field) {
+					key(name);
+					write(field);
+				});
+			end_object();
+		} else if constexpr (std::is_same_v<U, bool>) {
+			separate();
+			_out += value ? "true" : "false";
+		} else if constexpr (std::is_arithmetic_v<U>) {
+			separate();
+			if constexpr (std::is_integral_v<U>) {
+				using wide_t = std::conditional_t<std::is_signed_v<U>, long long, unsigned long long>;
+				write_number(static_cast<wide_t>(value));
+			} else {
+				write_number(value);
+			}
+		} else if constexpr (std::is_same_v<U, std::byte>) {
+			write(std::to_integer<unsigned>(value));
+		} else if constexpr (std::is_enum_v<U>) {
+			const auto name = magic_enum::enum_name(value);
+			if (name.empty()) {
+				write(static_cast<std::underlying_type_t<U>>(value));
+			} else {
+				string(name);
+			}
+		} else if constexpr (Detail::is_basic_string_v<U>) {
+			static_assert(std::is_same_v<typename U::value_type, char>, "ImReflect Error: only char strings are supported by the JSON writer");
+			string(value);
+		} else if constexpr (Detail::is_char_buffer_v<U>) {
+			string(Detail::char_buffer_text(value));
+		} else if constexpr (Detail::is_json_object_map_v<U>) {
+			begin_object();
+			for (const auto& [k, v] : value) {
+				write_key(k);
+				write(v);
+			}
+			end_object();
+		} else if constexpr (Detail::is_range_v<U>) {
+			begin_array();
+			for (const auto& element : value) write(element);
+			end_array();
+		} else if constexpr (Detail::is_tuple_like_v<U>) {
+			write_tuple(value, std::make_index_sequence<std::tuple_size_v<U>>{});
+		} else if constexpr (Detail::is_optional_v<U>) {
+			if (value.has_value()) write(*value);
+			else null();
+		} else if constexpr (Detail::is_variant_v<U>) {
+			if (value.valueless_by_exception()) {
+				null();
+				return;
+			}
+			begin_object();
+			key("index");
+			write(value.index());
+			key("value");
+			std::visit([&](const auto& alternative) { write(alternative); }, value);
+			end_object();
+		} else if constexpr (Detail::is_smart_pointer_v<U>) {
+			/* weak pointers don't own their value, they are not saved */
+			if constexpr (std::is_same_v<U, std::weak_ptr<typename U::element_type>>) {
+				null();
+			} else {
+				if (value) write(*value);
+				else null();
+			}
+		} else {
+			/* std::function and other values without data */
+			null();
+		}
+	}
+
+	template<typename Range>
+	bool json_reader::read_range(Range& value) {
+		using V = Detail::range_value_t<Range>;
+		if constexpr (Detail::is_fixed_range_v<Range>) {
+			const std::size_t size = Detail::range_size(value);
+			return read_array([&](std::size_t index) {
+				if (index >= size) return fail("too many array elements");
+				return read(value[index]);
+				});
+		} else if constexpr (Detail::is_map_like_v<Range>) {
+			using K = typename Range::key_type;
+			using M = typename Range::mapped_type;
+			value.clear();
+			if constexpr (Detail::is_json_object_map_v<Range>) {
+				return read_object([&](std::string_view text) {
+					K key{};
+					if (!read_key(text, key)) return false;
+					M mapped{};
+					if (!read(mapped)) return false;
+					value.emplace(std::move(key), std::move(mapped));
+					return true;
+					});
+			} else {
+				return read_array([&](std::size_t) {
+					std::pair<K, M> entry{};
+					if (!read(entry)) return false;
+					value.emplace(std::move(entry.first), std::move(entry.second));
+					return true;
+					});
+			}
+		} else if constexpr (Detail::has_emplace_back_v<Range>) {
+			value.clear();
+			return read_array([&](std::size_t) { return read(value.emplace_back()); });
+		} else if constexpr (Detail::has_emplace_after_v<Range>) {
+			value.clear();
+			auto last = value.before_begin();
+			return read_array([&](std::size_t) {
+				last = value.emplace_after(last);
+				return read(*last);
+				});
+		} else {
+			/* Sets: elements are const once inserted */
+			value.clear();
+			return read_array([&](std::size_t) {
+				V element{};
+				if (!read(element)) return false;
+				value.insert(std::move(element));
+				return true;
+				});
+		}
+	}
+
+	template<typename T>
+	bool json_reader::read(T& value) {
+		if (!ok()) return false;
+		using U = std::remove_cv_t<T>;
+		static_assert(!std::is_const_v<T>, "ImReflect Error: can't read JSON into a const value");
+
+		if constexpr (Detail::has_json_read_v<U>) {
+			tag_invoke(json_read, *this, value);
+			return ok();
+		} else if constexpr (Detail::is_reflected_v<U>) {
+			return read_object([&](std::string_view key) {
+				bool found = false;
+				visit_struct::context<Detail::ImContext>::for_each(value,
+					[&](const char* name, auto& field) {
+						if (found || key != name) return;
+						found = true;
+						if constexpr (!std::is_const_v<std::remove_reference_t<decltype(field)>>) {
+							read(field);
+						} else {
+							skip_value();
+						}
+					});
+				return found ? ok() : skip_value();
+				});
+		} else if constexpr (std::is_same_v<U, bool>) {
+			skip_whitespace();
+			if (_json.compare(_pos, 4, "true") == 0) {
+				value = true;
+				_pos += 4;
+			} else if (_json.compare(_pos, 5, "false") == 0) {
+				value = false;
+				_pos += 5;
+			} else {
+				return fail("expected bool");
+			}
+			return true;
+		} else if constexpr (std::is_arithmetic_v<U>) {
+			return read_number(value);
+		} else if constexpr (std::is_same_v<U, std::byte>) {
+			unsigned char number = 0;
+			if (!read_number(number)) return false;
+			value = std::byte{ number };
+			return true;
+		} else if constexpr (std::is_enum_v<U>) {
+			skip_whitespace();
+			if (_pos < _json.size() && _json[_pos] == '"') {
+				std::string_view name;
+				if (!read_string(name)) return false;
+				const auto parsed = magic_enum::enum_cast<U>(name);
+				if (!parsed.has_value()) return fail("unknown enum name");
+				value = *parsed;
+				return true;
+			}
+			std::underlying_type_t<U> underlying{};
+			if (!read_number(underlying)) return false;
+			value = static_cast<U>(underlying);
+			return true;
+		} else if constexpr (Detail::is_basic_string_v<U>) {
+			static_assert(std::is_same_v<typename U::value_type, char>, "ImReflect Error: only char strings are supported by the JSON reader");
+			std::string_view text;
+			if (!read_string(text)) return false;
+			value.assign(text.data(), text.size());
+			return true;
+		} else if constexpr (Detail::is_char_buffer_v<U>) {
+			std::string_view text;
+			if (!read_string(text)) return false;
+			char* data = std::data(value);
+			const std::size_t capacity = std::size(value);
+			if (text.size() > capacity) return fail("string too long for char buffer");
+			std::memcpy(data, text.data(), text.size());
+			std::memset(data + text.size(), 0, capacity - text.size());
+			return true;
+		} else if constexpr (Detail::is_range_v<U>) {
+			return read_range(value);
+		} else if constexpr (Detail::is_tuple_like_v<U>) {
+			return read_tuple(value, std::make_index_sequence<std::tuple_size_v<U>>{});
+		} else if constexpr (Detail::is_optional_v<U>) {
+			if (read_null()) {
+				value.reset();
+				return true;
+			}
+			return read(value.emplace());
+		} else if constexpr (Detail::is_variant_v<U>) {
+			if (read_null()) return true;
+			bool has_index = false;
+			std::size_t index = 0;
+			return read_object([&](std::string_view key) {
+				if (key == "index") {
+					has_index = read_number(index);
+					return has_index;
+				}
+				if (key == "value") {
+					if (!has_index) return fail("variant value before index");
+					return emplace_variant(value, index, std::make_index_sequence<std::variant_size_v<U>>{});
+				}
+				return skip_value();
+				});
+		} else if constexpr (Detail::is_smart_pointer_v<U>) {
+			using E = typename U::element_type;
+			if constexpr (std::is_same_v<U, std::weak_ptr<E>>) {
+				return skip_value();
+			} else {
+				if (read_null()) {
+					value.reset();
+					return true;
+				}
+				if (!value) {
+					if constexpr (std::is_default_constructible_v<E>) {
+						if constexpr (std::is_same_v<U, std::shared_ptr<E>>) value = std::make_shared<E>();
+						else value = std::make_unique<E>();
+					} else {
+						return fail("can't create pointee, type is not default constructible");
+					}
+				}
+				return read(*value);
+			}
+		} else {
+			return skip_value();
+		}
+	}
+
+	/* Append ``value`` as JSON to ``out`` */
+	template<typename T>
+	void WriteJson(const T& value, std::string& out, json_options options = {}) {
+		json_writer writer(out, options);
+		writer.write(value);
+	}
+
+	template<typename T>
+	std::string ToJson(const T& value, json_options options = {}) {
+		std::string out;
+		WriteJson(value, out, options);
+		return out;
+	}
+
+	/* Read ``json`` into ``value``. Fields missing from the text keep their current value. */
+	template<typename T>
+	json_result ReadJson(std::string_view json, T& value) {
+		json_reader reader(json);
+		if (reader.read(value) && !reader.at_end()) {
+			reader.fail("trailing characters");
+		}
+		return reader.result();
+	}
+}
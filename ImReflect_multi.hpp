@@ -0,0 +1,309 @@
+#pragma once
+#include <imgui.h>
+#include <imgui_internal.h>
+
+#include "ImReflect_entry.hpp"
+#include "ImReflect_helper.hpp"
+#include "ImReflect_traits.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+#if __cplusplus >= 202002L || (defined(_MSVC_LANG) && _MSVC_LANG >= 202002L)
+#include <span>
+#endif
+
+/*
+* Multi-object editing.
+*
+* The reflected type is walked once. Every leaf is compared across all selected instances,
+* shown as-is when they agree and with a "(mixed)" marker when they don't. An edit is written
+* to the same field of every instance. Compound leaves (containers, optionals...) that differ are
+* read only.
+*
+* Example:
+*	std::vector<Transform*> selection = ...;
+*	ImReflect::InputMulti("transform", selection);
+*
+*	Transform pool[512];
+*	ImReflect::InputMultiContiguous("transform", pool, 512);
+*/
+namespace ImReflect::Detail {
+
+	/* Selected instances, either an array of pointers or one contiguous block */
+	template<typename Root>
+	struct multi_items {
+		Root* const* pointers = nullptr;
+		Root* first = nullptr;
+		std::size_t count = 0;
+		const std::uint64_t* version = nullptr; /* bumped by the caller on outside changes, nullptr compares every frame */
+
+		Root* at(std::size_t i) const { return pointers ? pointers[i] : first + i; }
+	};
+
+	template<typename F, typename Root>
+	F& multi_field(const multi_items<Root>& items, std::size_t i, std::size_t offset) {
+		using byte_t = std::conditional_t<std::is_const_v<Root>, const char, char>;
+		return *reinterpret_cast<F*>(reinterpret_cast<byte_t*>(items.at(i)) + offset);
+	}
+
+	/* True when every instance is bitwise identical, lets all leaf checks be skipped */
+	template<typename Root>
+	bool multi_all_identical(const multi_items<Root>& items) {
+		if constexpr (std::has_unique_object_representations_v<std::remove_cv_t<Root>>) {
+			const Root* first = items.at(0);
+			if (items.pointers == nullptr) {
+				/* One block, memcmp against the first instance is as fast as it gets */
+				for (std::size_t i = 1; i < items.count; ++i) {
+					if (std::memcmp(first, first + i, sizeof(Root)) != 0) return false;
+				}
+			} else {
+				for (std::size_t i = 1; i < items.count; ++i) {
+					if (std::memcmp(first, items.pointers[i], sizeof(Root)) != 0) return false;
+				}
+			}
+			return true;
+		} else {
+			return items.count <= 1;
+		}
+	}
+
+	template<typename F, typename Root>
+	bool multi_values_agree(const multi_items<Root>& items, std::size_t offset) {
+		const F& first = multi_field<F>(items, 0, offset);
+		if constexpr (std::has_unique_object_representations_v<std::remove_cv_t<F>>) {
+			for (std::size_t i = 1; i < items.count; ++i) {
+				if (std::memcmp(&first, &multi_field<F>(items, i, offset), sizeof(F)) != 0) return false;
+			}
+			return true;
+		} else if constexpr (is_equality_comparable_v<F>) {
+			for (std::size_t i = 1; i < items.count; ++i) {
+				if (!(first == multi_field<F>(items, i, offset))) return false;
+			}
+			return true;
+		} else {
+			/* Can't tell, so don't pretend they agree */
+			return items.count <= 1;
+		}
+	}
+
+	/* Result of a comparison across the instances, kept while the caller's version stays the same */
+	struct multi_agree_cache {
+		std::uint64_t version = 0;
+		const void* first = nullptr;
+		std::size_t count = 0;
+		bool agree = false;
+		bool valid = false;
+
+		template<typename Root, typename Compare>
+		bool get(const multi_items<Root>& items, Compare compare) {
+			if (items.version == nullptr) return compare();
+			const void* const first_item = items.at(0);
+			if (!valid || version != *items.version || first != first_item || count != items.count) {
+				agree = compare();
+				version = *items.version;
+				first = first_item;
+				count = items.count;
+				valid = true;
+			}
+			return agree;
+		}
+	};
+
+	/* Entry of the cache for the widget ``label``, under its own id */
+	inline multi_agree_cache& multi_cache(const char* label, const char* key) {
+		ImGui::PushID(label);
+		const ImGuiID id = ImGui::GetID(key);
+		ImGui::PopID();
+		return widget_store::current().get<multi_agree_cache>(id);
+	}
+
+	/* Edited as one value: an edit replaces the whole value, so it may be copied to every instance */
+	template<typename T>
+	constexpr bool is_multi_scalar_v = is_text_leaf_v<T> ||
+		svh::is_tag_invocable_v<ImInput_t, const char*, T&, ImSettings&, ImResponse&>;
+
+	template<typename F, typename Root>
+	void multi_input_leaf(const char* label, const multi_items<Root>& items, std::size_t offset, bool identical, ImSettings& settings, ImResponse& response) {
+		using U = std::remove_cv_t<F>;
+		if constexpr (!std::is_copy_constructible_v<U> || !std::is_copy_assignable_v<U>) {
+			ImGui::TextDisabled("%s: not editable on multiple objects", label);
+			imgui_tooltip("Type is not copy constructible/assignable");
+		} else {
+			multi_agree_cache& cache = multi_cache(label, "##multi_agree");
+			const bool agree = identical || cache.get(items, [&] { return multi_values_agree<F>(items, offset); });
+
+			/*
+			* Edit the first instance, then copy it to the others. For containers, optionals, tuples...
+			* one edit only touches part of the value, copying the rest of the first instance over
+			* values that differ would lose them, so those are shown read only.
+			*/
+			const bool read_only = !agree && !is_multi_scalar_v<U>;
+			F& first = multi_field<F>(items, 0, offset);
+			if (!agree) ImGui::PushItemFlag(ImGuiItemFlags_MixedValue, true);
+			if (read_only) ImGui::BeginDisabled();
+			{
+				const scope_suspend_journal suspend; /* only one of the edited instances */
+				InputImpl(label, first, settings, response);
+			}
+			if (read_only) ImGui::EndDisabled();
+			if (!agree) {
+				ImGui::PopItemFlag();
+				ImGui::SameLine();
+				ImGui::TextDisabled("(mixed)");
+				imgui_tooltip(read_only
+					? "Values differ between the selected objects, edit them one at a time"
+					: "Values differ between the selected objects, editing sets all of them");
+			}
+
+			if constexpr (!std::is_const_v<F>) {
+				if (!read_only && response.get<U>().is_changed()) {
+					for (std::size_t i = 1; i < items.count; ++i) {
+						multi_field<F>(items, i, offset) = first;
+					}
+					cache.agree = true;
+				}
+			}
+		}
+	}
+
+	template<typename F, typename Root>
+	void multi_input(const char* label, const multi_items<Root>& items, std::size_t offset, bool identical, ImSettings& settings, ImResponse& response) {
+		using U = std::remove_cv_t<F>;
+
+		/* Same resolution order as InputImpl: user implementations win over reflection */
+		if constexpr (!svh::is_tag_invocable_v<ImInput_t, const char*, F&, ImSettings&, ImResponse&> && is_reflected_v<U>) {
+			auto& type_settings = settings.get<U>();
+			auto& type_response = response.get<U>();
+			F& first = multi_field<F>(items, 0, offset);
+
+			const auto id = scope_id(label);
+			const bool empty = std::string(label).empty();
+			if (!empty) ImGui::SeparatorText(label);
+			if (!empty) ImGui::Indent();
+			visit_struct::context<ImContext>::for_each(first,
+				[&](const char* name, auto& field) {
+					using M = std::remove_reference_t<decltype(field)>;
+					const std::size_t member_offset = offset + static_cast<std::size_t>(
+						reinterpret_cast<const char*>(&field) - reinterpret_cast<const char*>(&first));
+
+					auto& member_settings = type_settings.get_member(first, field);
+					auto& member_response = type_response.get_member(first, field);
+					const std::string member_label = member_settings.has_label() ? member_settings.get_label() : name;
+
+					ImGui::PushID(name);
+					multi_input<M>(member_label.c_str(), items, member_offset, identical, member_settings, member_response);
+					ImGui::PopID();
+				});
+			if (!empty) ImGui::Unindent();
+		} else {
+			multi_input_leaf<F>(label, items, offset, identical, settings, response);
+		}
+	}
+
+	template<typename T>
+	ImResponse input_multi(const char* label, const multi_items<T>& items, ImSettings& settings) {
+		ImResponse response;
+		if (items.count == 0) {
+			ImGui::TextDisabled("%s: nothing selected", label);
+			return response;
+		}
+		multi_agree_cache& cache = multi_cache(label, "##multi_identical");
+		const bool identical = cache.get(items, [&] { return multi_all_identical(items); });
+		multi_input<T>(label, items, 0, identical, settings, response);
+		if (response.get<std::remove_cv_t<T>>().is_changed()) cache.valid = false; /* edits may have made them identical */
+		return response;
+	}
+}
+
+namespace ImReflect {
+
+	/* Edit ``count`` instances given by pointer */
+	template<typename T>
+	ImResponse InputMulti(const char* label, T* const* items, std::size_t count, ImSettings& settings) {
+		Detail::multi_items<T> view;
+		view.pointers = items;
+		view.count = count;
+		return Detail::input_multi(label, view, settings);
+	}
+
+	/*
+	* Compares the instances only again when ``version`` changes or another selection is passed,
+	* instead of every frame. Bump it whenever an instance is changed outside of this widget.
+	*/
+	template<typename T>
+	ImResponse InputMulti(const char* label, T* const* items, std::size_t count, ImSettings& settings, std::uint64_t version) {
+		Detail::multi_items<T> view;
+		view.pointers = items;
+		view.count = count;
+		view.version = &version;
+		return Detail::input_multi(label, view, settings);
+	}
+
+	template<typename T>
+	ImResponse InputMulti(const char* label, T* const* items, std::size_t count) {
+		ImSettings settings;
+		return InputMulti(label, items, count, settings);
+	}
+
+	template<typename T>
+	ImResponse InputMulti(const char* label, const std::vector<T*>& items, ImSettings& settings) {
+		return InputMulti(label, items.data(), items.size(), settings);
+	}
+
+	template<typename T>
+	ImResponse InputMulti(const char* label, const std::vector<T*>& items, ImSettings& settings, std::uint64_t version) {
+		return InputMulti(label, items.data(), items.size(), settings, version);
+	}
+
+	template<typename T>
+	ImResponse InputMulti(const char* label, const std::vector<T*>& items) {
+		ImSettings settings;
+		return InputMulti(label, items.data(), items.size(), settings);
+	}
+
+#if __cplusplus >= 202002L || (defined(_MSVC_LANG) && _MSVC_LANG >= 202002L)
+	template<typename T, std::size_t N>
+	ImResponse InputMulti(const char* label, std::span<T* const, N> items, ImSettings& settings) {
+		return InputMulti(label, items.data(), items.size(), settings);
+	}
+
+	template<typename T, std::size_t N>
+	ImResponse InputMulti(const char* label, std::span<T*, N> items, ImSettings& settings) {
+		return InputMulti(label, items.data(), items.size(), settings);
+	}
+
+	template<typename T, std::size_t N>
+	ImResponse InputMulti(const char* label, std::span<T*, N> items) {
+		ImSettings settings;
+		return InputMulti(label, items.data(), items.size(), settings);
+	}
+#endif
+
+	/* Edit ``count`` instances stored next to each other, e.g. a component pool */
+	template<typename T>
+	ImResponse InputMultiContiguous(const char* label, T* first, std::size_t count, ImSettings& settings) {
+		Detail::multi_items<T> view;
+		view.first = first;
+		view.count = count;
+		return Detail::input_multi(label, view, settings);
+	}
+
+	/* See ``InputMulti`` taking a version */
+	template<typename T>
+	ImResponse InputMultiContiguous(const char* label, T* first, std::size_t count, ImSettings& settings, std::uint64_t version) {
+		Detail::multi_items<T> view;
+		view.first = first;
+		view.count = count;
+		view.version = &version;
+		return Detail::input_multi(label, view, settings);
+	}
+
+	template<typename T>
+	ImResponse InputMultiContiguous(const char* label, T* first, std::size_t count) {
+		ImSettings settings;
+		return InputMultiContiguous(label, first, count, settings);
+	}
+}
@@ -0,0 +1,481 @@
+#pragma once
+#include <extern/svh/scope.hpp>
+#include <extern/magic_enum/magic_enum.hpp>
+
+#include "ImReflect_entry.hpp"
+#include "ImReflect_helper.hpp"
+#include "ImReflect_traits.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__)
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+/*
+* Settings presets in a text file, reloaded while the application runs.
+*
+*	# comment
+*	[float]              ; a bound type
+*	as_slider
+*	min = 0
+*	max = 10
+*	format = "%.2f"
+*
+*	[player.health]      ; a member of a bound reflected type
+*	label = HP
+*
+* Properties are the settings functions of the type, without arguments or with one.
+* On reload only the entries that changed are applied. A section that lost entries is restored
+* to what it was before the preset touched it and applied again. Every section that was applied
+* gets its ``generation()`` bumped.
+*
+* Example:
+*	static ImSettings settings;
+*	static ImReflect::settings_preset preset(settings);
+*	preset.bind<float>("float");
+*	preset.bind<player>("player");
+*	preset.watch("ui.preset"); // loads it now
+*
+*	preset.poll(); // every frame, reapplies the file when it changed
+*/
+namespace ImReflect {
+
+	struct preset_result {
+		const char* error = nullptr; /* first error, nullptr when everything applied */
+		std::size_t line = 0;        /* line of the first error, 1 based */
+		std::size_t applied = 0;     /* entries applied */
+
+		explicit operator bool() const { return error == nullptr; }
+	};
+}
+
+namespace ImReflect::Detail {
+
+	inline std::string_view preset_trim(std::string_view text) {
+		const auto is_space = [](char c) { return c == ' ' || c == '\t' || c == '\r'; };
+		while (!text.empty() && is_space(text.front())) text.remove_prefix(1);
+		while (!text.empty() && is_space(text.back())) text.remove_suffix(1);
+		return text;
+	}
+
+	template<typename A>
+	bool parse_preset_value(std::string_view text, A& out) {
+		if constexpr (std::is_same_v<A, bool>) {
+			if (text.empty() || text == "true" || text == "1") out = true;
+			else if (text == "false" || text == "0") out = false;
+			else return false;
+			return true;
+		} else if constexpr (std::is_same_v<A, char>) {
+			if (text.size() != 1) return false;
+			out = text[0];
+			return true;
+		} else if constexpr (std::is_arithmetic_v<A>) {
+			const auto result = std::from_chars(text.data(), text.data() + text.size(), out);
+			return result.ec == std::errc() && result.ptr == text.data() + text.size();
+		} else if constexpr (std::is_enum_v<A>) {
+			const auto parsed = magic_enum::enum_cast<A>(text);
+			if (!parsed.has_value()) return false;
+			out = *parsed;
+			return true;
+		} else if constexpr (std::is_same_v<A, std::string>) {
+			out.assign(text.data(), text.size());
+			return true;
+		} else {
+			return false;
+		}
+	}
+
+	/* Argument type of a one argument settings function */
+	template<typename C, typename R, typename A>
+	A preset_first_arg(R(C::*)(A));
+
+	/* A detector and an invoker per property name */
+#define IMREFLECT_PRESET_PROPERTY(name)                                                                                     \
+	template<typename S, typename = void>                                                                                   \
+	struct preset_nullary_##name : std::false_type {};                                                                      \
+	template<typename S>                                                                                                    \
+	struct preset_nullary_##name<S, std::void_t<decltype(std::declval<S&>().name())>> : std::true_type {};                \
+	template<typename S, typename = void>                                                                                   \
+	struct preset_unary_##name { using type = void; };                                                                      \
+	template<typename S>                                                                                                    \
+	struct preset_unary_##name<S, std::void_t<decltype(preset_first_arg(&S::name))>> {                                     \
+		using type = std::remove_cv_t<std::remove_reference_t<decltype(preset_first_arg(&S::name))>>;                      \
+	};                                                                                                                      \
+	template<typename S>                                                                                                    \
+	bool preset_invoke_##name(S& settings, std::string_view value, const char*& error) {                                    \
+		if constexpr (preset_nullary_##name<S>::value) {                                                                    \
+			if (value.empty()) {                                                                                            \
+				settings.name();                                                                                            \
+				return true;                                                                                                \
+			}                                                                                                               \
+		}                                                                                                                   \
+		using A = typename preset_unary_##name<S>::type;                                                                    \
+		if constexpr (!std::is_void_v<A>) {                                                                                 \
+			A arg{};                                                                                                        \
+			if (!parse_preset_value(value, arg)) {                                                                          \
+				error = "invalid value";                                                                                    \
+				return false;                                                                                               \
+			}                                                                                                               \
+			settings.name(arg);                                                                                             \
+			return true;                                                                                                    \
+		} else {                                                                                                            \
+			error = preset_nullary_##name<S>::value ? "property takes no value" : "property not supported by this type";   \
+			return false;                                                                                                   \
+		}                                                                                                                   \
+	}
+
+	/* Every settings function a preset can call */
+#define IMREFLECT_PRESET_PROPERTIES(X)                                                                                      \
+	X(disable) X(same_line) X(separator) X(label) X(deferred_commit) X(min_width)                                         \
+	X(min) X(max) X(clamp) X(step) X(step_fast) X(speed)                                                                    \
+	X(prefix) X(format) X(suffix) X(clear_format)                                                                           \
+	X(as_decimal) X(as_unsigned) X(as_hex) X(as_octal) X(as_float) X(as_double) X(as_scientific) X(as_general)            \
+	X(as_char) X(as_percentage) X(true_text) X(false_text)                                                                  \
+	X(logarithmic) X(no_round_to_format) X(no_input) X(wrap_around) X(clamp_on_input) X(clamp_zero_range)                 \
+	X(no_speed_tweaks) X(always_clamp)                                                                                      \
+	X(as_input) X(as_drag) X(as_slider) X(as_radio) X(as_checkbox) X(as_dropdown) X(as_button)                            \
+	X(chars_decimal) X(chars_hexadecimal) X(chars_scientific) X(chars_uppercase) X(chars_no_blank) X(allow_tab_input)     \
+	X(enter_returns_true) X(escape_clears_all) X(read_only) X(password) X(auto_select_all) X(no_horizontal_scroll)        \
+	X(no_undo_redo) X(as_multiline) X(reorderable) X(insertable) X(pop_up_on_insert) X(removable) X(async)
+
+	IMREFLECT_PRESET_PROPERTIES(IMREFLECT_PRESET_PROPERTY)
+
+	template<typename S>
+	bool apply_preset_property(S& settings, std::string_view key, std::string_view value, const char*& error) {
+#define IMREFLECT_PRESET_DISPATCH(name) if (key == #name) return preset_invoke_##name(settings, value, error);
+		IMREFLECT_PRESET_PROPERTIES(IMREFLECT_PRESET_DISPATCH)
+#undef IMREFLECT_PRESET_DISPATCH
+		error = "unknown property";
+		return false;
+	}
+
+#undef IMREFLECT_PRESET_PROPERTY
+
+	/* One ``[section]``: where its settings live and how to change them, type erased */
+	struct preset_binding {
+		std::function<void* (ImSettings&)> resolve;
+		std::function<bool(void*, std::string_view, std::string_view, const char*&)> apply;
+		std::function<std::shared_ptr<void>(const void*)> snapshot;
+		std::function<void(void*, const void*)> restore;
+		std::function<void(void*)> bump;
+	};
+
+	/* The generation only ever goes up, also when settings are restored */
+	template<typename T>
+	void keep_generation(type_settings<T>& to, const type_settings<T>& from) {
+		static_cast<generation_mixin<T>&>(to) = static_cast<const generation_mixin<T>&>(from);
+	}
+
+	template<typename S, typename Resolve>
+	preset_binding make_preset_binding(Resolve&& resolve) {
+		preset_binding binding;
+		binding.resolve = [r = std::forward<Resolve>(resolve)](ImSettings& root) -> void* { return &r(root); };
+		binding.apply = [](void* settings, std::string_view key, std::string_view value, const char*& error) {
+			return apply_preset_property(*static_cast<S*>(settings), key, value, error);
+			};
+		binding.snapshot = [](const void* settings) -> std::shared_ptr<void> {
+			return std::make_shared<S>(*static_cast<const S*>(settings));
+			};
+		binding.restore = [](void* settings, const void* baseline) {
+			/* Restore the values, but keep the scope links (parent, children) of the live settings */
+			S& live = *static_cast<S*>(settings);
+			S restored = *static_cast<const S*>(baseline);
+			static_cast<ImSettings&>(restored) = static_cast<const ImSettings&>(live);
+			keep_generation(restored, live);
+			live = std::move(restored);
+			};
+		binding.bump = [](void* settings) { static_cast<S*>(settings)->bump_generation(); };
+		return binding;
+	}
+
+	struct preset_entry {
+		std::string key;
+		std::string value;
+		std::size_t line = 0;
+	};
+
+	struct preset_section {
+		std::string name;
+		std::vector<preset_entry> entries;
+		std::size_t line = 0;
+	};
+
+	/* Split the text into sections, later duplicates of a key win */
+	inline bool parse_preset(std::string_view text, std::vector<preset_section>& out, preset_result& result) {
+		std::size_t line_number = 0;
+		while (!text.empty()) {
+			const std::size_t end = text.find('\n');
+			std::string_view line = text.substr(0, end);
+			text = end == std::string_view::npos ? std::string_view() : text.substr(end + 1);
+			++line_number;
+
+			/* Comments start with # or ; outside of quotes */
+			bool quoted = false;
+			for (std::size_t i = 0; i < line.size(); ++i) {
+				if (line[i] == '"') quoted = !quoted;
+				else if (!quoted && (line[i] == '#' || line[i] == ';')) {
+					line = line.substr(0, i);
+					break;
+				}
+			}
+			line = preset_trim(line);
+			if (line.empty()) continue;
+
+			if (line.front() == '[') {
+				if (line.back() != ']') {
+					result = { "expected ']'", line_number, 0 };
+					return false;
+				}
+				preset_section section;
+				section.name = std::string(preset_trim(line.substr(1, line.size() - 2)));
+				section.line = line_number;
+				out.push_back(std::move(section));
+				continue;
+			}
+
+			if (out.empty()) {
+				result = { "property outside of a [section]", line_number, 0 };
+				return false;
+			}
+
+			const std::size_t equals = line.find('=');
+			const std::string_view key = preset_trim(line.substr(0, equals));
+			std::string_view value = equals == std::string_view::npos ? std::string_view() : preset_trim(line.substr(equals + 1));
+			if (value.size() >= 2 && value.front() == '"' && value.back() == '"') {
+				value = value.substr(1, value.size() - 2);
+			}
+
+			auto& entries = out.back().entries;
+			auto existing = std::find_if(entries.begin(), entries.end(), [&](const preset_entry& e) { return e.key == key; });
+			if (existing != entries.end()) {
+				existing->value = std::string(value);
+				existing->line = line_number;
+			} else {
+				entries.push_back({ std::string(key), std::string(value), line_number });
+			}
+		}
+		return true;
+	}
+}
+
+namespace ImReflect {
+
+	class settings_preset {
+	public:
+		explicit settings_preset(ImSettings& settings) : _settings(settings) {}
+		~settings_preset() { unwatch(); }
+
+		settings_preset(const settings_preset&) = delete;
+		settings_preset& operator=(const settings_preset&) = delete;
+
+		/* Make ``[name]`` refer to ``push<T>()``, and ``[name.member]`` to the members of a reflected ``T`` */
+		template<typename T>
+		settings_preset& bind(const std::string& name) {
+			using S = std::remove_reference_t<decltype(std::declval<ImSettings&>().push<T>())>;
+			_bindings[name] = Detail::make_preset_binding<S>([](ImSettings& root) -> S& { return root.push<T>(); });
+
+			if constexpr (Detail::is_reflected_v<T>) {
+				bind_members<T>(name, std::make_index_sequence<visit_struct::context<Detail::ImContext>::field_count<T>()>{});
+			}
+			return *this;
+		}
+
+		/* Apply a preset, only what differs from the previously applied text is touched */
+		preset_result apply(std::string_view text) {
+			preset_result result;
+			std::vector<Detail::preset_section> sections;
+			if (!Detail::parse_preset(text, sections, result)) return result;
+
+			const auto report = [&](const char* error, std::size_t line) {
+				if (result.error == nullptr) {
+					result.error = error;
+					result.line = line;
+				}
+				};
+
+			/* Sections that are gone go back to how they were */
+			for (auto it = _applied.begin(); it != _applied.end();) {
+				const bool kept = std::any_of(sections.begin(), sections.end(), [&](const Detail::preset_section& s) { return s.name == it->first; });
+				if (!kept) {
+					restore(it->first, it->second);
+					it = _applied.erase(it);
+				} else {
+					++it;
+				}
+			}
+
+			for (const auto& section : sections) {
+				const auto binding_it = _bindings.find(section.name);
+				if (binding_it == _bindings.end()) {
+					report("unknown section, bind<T>() it first", section.line);
+					continue;
+				}
+				const Detail::preset_binding& binding = binding_it->second;
+				void* settings = binding.resolve(_settings);
+
+				applied_section& state = _applied[section.name];
+				if (!state.baseline) state.baseline = binding.snapshot(settings);
+
+				/* A removed key can't be undone on its own, start over from the baseline */
+				const bool removed = std::any_of(state.entries.begin(), state.entries.end(), [&](const Detail::preset_entry& old) {
+					return std::none_of(section.entries.begin(), section.entries.end(), [&](const Detail::preset_entry& e) { return e.key == old.key; });
+					});
+				if (removed) {
+					binding.restore(settings, state.baseline.get());
+					state.entries.clear();
+				}
+
+				bool touched = removed;
+				for (const auto& entry : section.entries) {
+					const auto old = std::find_if(state.entries.begin(), state.entries.end(), [&](const Detail::preset_entry& e) { return e.key == entry.key; });
+					if (old != state.entries.end() && old->value == entry.value) continue;
+
+					const char* error = nullptr;
+					if (binding.apply(settings, entry.key, entry.value, error)) {
+						++result.applied;
+						touched = true;
+					} else {
+						report(error, entry.line);
+					}
+				}
+				state.entries = section.entries;
+				if (touched) binding.bump(settings);
+			}
+			return result;
+		}
+
+		preset_result load(const char* path) {
+			std::string text;
+			if (!read_file(path, text)) return { "can't read file", 0, 0 };
+			return apply(text);
+		}
+
+		/* Load ``path`` now and again whenever ``poll()`` sees it changed */
+		preset_result watch(const char* path) {
+			unwatch();
+			_path = path;
+			_last_write = modified_time();
+#if defined(__linux__)
+			/* Watch the directory, editors often replace the file instead of writing to it */
+			const std::filesystem::path file(_path);
+			const std::string directory = file.has_parent_path() ? file.parent_path().string() : std::string(".");
+			_inotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+			if (_inotify >= 0 && inotify_add_watch(_inotify, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE) < 0) {
+				::close(_inotify);
+				_inotify = -1;
+			}
+#endif
+			return load(_path.c_str());
+		}
+
+		void unwatch() {
+#if defined(__linux__)
+			if (_inotify >= 0) ::close(_inotify);
+			_inotify = -1;
+#endif
+			_path.clear();
+		}
+
+		/* Seconds between modification time checks, when no change notifications are available */
+		settings_preset& poll_interval(float seconds) { _poll_interval = seconds; return *this; }
+
+		/* Reapply the watched file if it changed, cheap enough to call every frame */
+		preset_result poll() {
+			if (_path.empty() || !file_changed()) return {};
+			_last_write = modified_time();
+			return load(_path.c_str());
+		}
+
+	private:
+		struct applied_section {
+			std::vector<Detail::preset_entry> entries; /* as last applied */
+			std::shared_ptr<void> baseline;             /* settings before the preset touched them */
+		};
+
+		/* ``[name.member]`` is the same as ``push_member<&T::member>()`` */
+		template<typename T, std::size_t... I>
+		void bind_members(const std::string& name, std::index_sequence<I...>) {
+			using ctx = visit_struct::context<Detail::ImContext>;
+			(bind_member<T, ctx::get_pointer<static_cast<int>(I), T>()>(name + "." + ctx::get_name<static_cast<int>(I), T>()), ...);
+		}
+
+		template<typename T, auto member>
+		void bind_member(const std::string& name) {
+			using S = std::remove_reference_t<decltype(std::declval<ImSettings&>().push_member<member>())>;
+			_bindings[name] = Detail::make_preset_binding<S>([](ImSettings& root) -> S& { return root.push_member<member>(); });
+		}
+
+		void restore(const std::string& name, const applied_section& state) {
+			const auto binding_it = _bindings.find(name);
+			if (binding_it == _bindings.end() || !state.baseline) return;
+			void* settings = binding_it->second.resolve(_settings);
+			binding_it->second.restore(settings, state.baseline.get());
+			binding_it->second.bump(settings);
+		}
+
+		static bool read_file(const char* path, std::string& out) {
+			std::FILE* file = std::fopen(path, "rb");
+			if (file == nullptr) return false;
+			char buffer[4096];
+			std::size_t read = 0;
+			while ((read = std::fread(buffer, 1, sizeof(buffer), file)) > 0) out.append(buffer, read);
+			std::fclose(file);
+			return true;
+		}
+
+		std::filesystem::file_time_type modified_time() const {
+			std::error_code error;
+			const auto time = std::filesystem::last_write_time(_path, error);
+			return error ? std::filesystem::file_time_type{} : time;
+		}
+
+		bool file_changed() {
+#if defined(__linux__)
+			if (_inotify >= 0) {
+				const std::string name = std::filesystem::path(_path).filename().string();
+				alignas(inotify_event) char buffer[4096];
+				bool changed = false;
+				ssize_t length = 0;
+				while ((length = ::read(_inotify, buffer, sizeof(buffer))) > 0) {
+					for (char* at = buffer; at < buffer + length;) {
+						const auto* event = reinterpret_cast<const inotify_event*>(at);
+						if (event->len > 0 && name == event->name) changed = true;
+						at += sizeof(inotify_event) + event->len;
+					}
+				}
+				return changed;
+			}
+#endif
+			const auto now = std::chrono::steady_clock::now();
+			if (now - _last_poll < std::chrono::duration<float>(_poll_interval)) return false;
+			_last_poll = now;
+			return modified_time() != _last_write;
+		}
+
+		ImSettings& _settings;
+		std::unordered_map<std::string, Detail::preset_binding> _bindings;
+		std::unordered_map<std::string, applied_section> _applied;
+
+		std::string _path;
+		std::filesystem::file_time_type _last_write{};
+		std::chrono::steady_clock::time_point _last_poll{};
+		float _poll_interval = 0.5f;
+#if defined(__linux__)
+		int _inotify = -1;
+#endif
+	};
+}
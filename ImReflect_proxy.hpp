@@ -0,0 +1,300 @@
+#pragma once
+#include <imgui.h>
+
+#include "ImReflect_entry.hpp"
+#include "ImReflect_helper.hpp"
+#include "ImReflect_record.hpp"
+#include "ImReflect_traits.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <type_traits>
+#include <variant>
+#include <vector>
+
+/*
+* Inspect an object that is owned by another thread without racing it.
+*
+* The owning thread publishes snapshots into a lock-free triple buffer, the UI thread draws the
+* newest one. Publishing only copies the fields that changed: every buffer keeps a hash per field
+* and a field is assigned only when the hash of the live value differs.
+* Edits made in the UI are recorded as path/value logs (see ImReflect_record.hpp) and pushed
+* through a lock-free single-producer single-consumer queue; the owner applies them at a safe point.
+* Container inserts, removals and bulk operations travel as whole-container records. A change the
+* recorder can't carry is dropped: the owner overwrites the edited buffer on the next publish.
+*
+* Example:
+*	static ImReflect::thread_proxy<world_state> proxy;
+*
+*	// Worker thread, once per step
+*	proxy.apply_edits(world);
+*	proxy.publish(world);
+*
+*	// UI thread
+*	proxy.input("world", settings);
+*/
+namespace ImReflect {
+
+	namespace Detail {
+		inline void proxy_mix(std::uint64_t& hash, std::uint64_t value) {
+			hash ^= value + 0x9E3779B97F4A7C15ull + (hash << 6) + (hash >> 2);
+		}
+
+		inline void proxy_hash_bytes(std::uint64_t& hash, const void* data, std::size_t size) {
+			const unsigned char* bytes = static_cast<const unsigned char*>(data);
+			for (; size >= sizeof(std::uint64_t); size -= sizeof(std::uint64_t), bytes += sizeof(std::uint64_t)) {
+				std::uint64_t word;
+				std::memcpy(&word, bytes, sizeof(word));
+				proxy_mix(hash, word);
+			}
+			std::uint64_t tail = 0;
+			if (size != 0) std::memcpy(&tail, bytes, size);
+			proxy_mix(hash, tail ^ (std::uint64_t(size) << 56));
+		}
+
+		/* Hash of a value, false when the type can't be hashed and has to be copied every time */
+		template<typename T>
+		bool proxy_hash(const T& value, std::uint64_t& hash);
+
+		template<typename T, std::size_t... I>
+		bool proxy_hash_members(const T& value, std::uint64_t& hash, std::index_sequence<I...>) {
+			using ctx = visit_struct::context<ImContext>;
+			return (proxy_hash(value.*(ctx::get_pointer<static_cast<int>(I), T>()), hash) && ...);
+		}
+
+		template<typename T, std::size_t... I>
+		bool proxy_hash_tuple(const T& value, std::uint64_t& hash, std::index_sequence<I...>) {
+			return (proxy_hash(std::get<I>(value), hash) && ...);
+		}
+
+		template<typename T>
+		bool proxy_hash(const T& value, std::uint64_t& hash) {
+			using U = std::remove_cv_t<T>;
+			if constexpr (std::is_trivially_copyable_v<U>) {
+				proxy_hash_bytes(hash, &value, sizeof(U)); /* padding at worst causes an extra copy */
+				return true;
+			} else if constexpr (is_basic_string_v<U>) {
+				proxy_hash_bytes(hash, value.data(), value.size() * sizeof(typename U::value_type));
+				return true;
+			} else if constexpr (is_reflected_v<U>) {
+				return proxy_hash_members(value, hash, std::make_index_sequence<visit_struct::context<ImContext>::field_count<U>()>{});
+			} else if constexpr (is_range_v<U>) {
+				using V = range_value_t<U>;
+				if constexpr (is_std_vector_v<U> && !std::is_same_v<V, bool> && std::is_trivially_copyable_v<V>) {
+					proxy_hash_bytes(hash, value.data(), value.size() * sizeof(V));
+					return true;
+				} else {
+					std::uint64_t count = 0;
+					for (const auto& element : value) {
+						if (!proxy_hash(element, hash)) return false;
+						++count;
+					}
+					proxy_mix(hash, count);
+					return true;
+				}
+			} else if constexpr (is_tuple_like_v<U>) {
+				return proxy_hash_tuple(value, hash, std::make_index_sequence<std::tuple_size_v<U>>{});
+			} else if constexpr (is_optional_v<U>) {
+				proxy_mix(hash, value.has_value());
+				return !value.has_value() || proxy_hash(*value, hash);
+			} else if constexpr (is_variant_v<U>) {
+				proxy_mix(hash, value.index());
+				return value.valueless_by_exception() || std::visit([&](const auto& alternative) { return proxy_hash(alternative, hash); }, value);
+			} else if constexpr (is_smart_pointer_v<U>) {
+				/* Only the pointer is copied, so only the pointer counts */
+				if constexpr (std::is_same_v<U, std::weak_ptr<typename U::element_type>>) return false;
+				else proxy_mix(hash, reinterpret_cast<std::uintptr_t>(value.get()));
+				return true;
+			} else {
+				return false;
+			}
+		}
+
+		/* Fields that are synced one by one: members of reflected structs, recursively */
+		template<typename T>
+		constexpr std::size_t proxy_field_count();
+
+		template<typename T, std::size_t... I>
+		constexpr std::size_t proxy_member_count(std::index_sequence<I...>) {
+			using ctx = visit_struct::context<ImContext>;
+			return (std::size_t(0) + ... + proxy_field_count<ctx::type_at<static_cast<int>(I), T>>());
+		}
+
+		template<typename T>
+		constexpr std::size_t proxy_field_count() {
+			using U = std::remove_cv_t<T>;
+			if constexpr (is_reflected_v<U>) {
+				return proxy_member_count<U>(std::make_index_sequence<visit_struct::context<ImContext>::field_count<U>()>{});
+			} else {
+				return 1;
+			}
+		}
+
+		/* Assign the fields of ``live`` whose hash differs from the one stored for ``copy`` */
+		struct proxy_sync {
+			std::uint64_t* hash;
+			bool force;
+			std::size_t copied = 0;
+
+			template<typename T, std::size_t... I>
+			void members(const T& live, T& copy, std::index_sequence<I...>) {
+				using ctx = visit_struct::context<ImContext>;
+				(sync(live.*(ctx::get_pointer<static_cast<int>(I), T>()), copy.*(ctx::get_pointer<static_cast<int>(I), T>())), ...);
+			}
+
+			template<typename F>
+			void sync(const F& live, F& copy) {
+				using U = std::remove_cv_t<F>;
+				if constexpr (is_reflected_v<U>) {
+					members(live, copy, std::make_index_sequence<visit_struct::context<ImContext>::field_count<U>()>{});
+				} else {
+					std::uint64_t value_hash = 14695981039346656037ull;
+					const bool hashed = proxy_hash(live, value_hash);
+					if (force || !hashed || value_hash != *hash) {
+						if constexpr (std::is_copy_assignable_v<F>) {
+							copy = live;
+							++copied;
+						}
+						*hash = value_hash;
+					}
+					++hash;
+				}
+			}
+		};
+	}
+
+	template<typename T>
+	class thread_proxy {
+		static_assert(std::is_copy_assignable_v<T> && std::is_default_constructible_v<T>,
+			"ImReflect Error: thread_proxy<T> needs a default constructible, copy assignable T");
+
+	public:
+		explicit thread_proxy(std::size_t queue_capacity = 64) : _queue(std::max<std::size_t>(queue_capacity, 1)) {
+			for (std::size_t i = 0; i < _buffers.size(); ++i) {
+				_buffers[i].recorder = std::make_unique<edit_recorder>(_buffers[i].value);
+			}
+		}
+
+		thread_proxy(const thread_proxy&) = delete;
+		thread_proxy& operator=(const thread_proxy&) = delete;
+
+		/* --- Owner thread --- */
+
+		/* Copy the changed fields of ``live`` into a free buffer and hand it to the UI. Never blocks. */
+		void publish(const T& live) {
+			buffer& back = _buffers[_back];
+			Detail::proxy_sync sync{ back.hashes.data(), back.edited.exchange(false, std::memory_order_acquire) || !back.synced };
+			sync.sync(live, back.value);
+			back.synced = true;
+			_copied_fields = sync.copied;
+			_back = _ready.exchange(_back | fresh, std::memory_order_acq_rel) & index_mask;
+		}
+
+		/* Apply the edits made in the UI since the last call, returns the number of edits applied */
+		std::size_t apply_edits(T& live) {
+			std::size_t applied = 0;
+			std::size_t tail = _tail.load(std::memory_order_relaxed);
+			while (tail != _head.load(std::memory_order_acquire)) {
+				const std::vector<unsigned char>& log = _queue[tail % _queue.size()];
+				/* The owner kept going while the UI edited, the old values are stale by design */
+				applied += Replay(log, live, false).applied;
+				++tail;
+				_tail.store(tail, std::memory_order_release);
+			}
+			return applied;
+		}
+
+		/* Fields the last ``publish`` had to copy */
+		std::size_t copied_fields() const { return _copied_fields; }
+		static constexpr std::size_t field_count() { return Detail::proxy_field_count<T>(); }
+
+		/* --- UI thread --- */
+
+		/* Newest published snapshot, nullptr before the first ``publish`` */
+		const T* get() {
+			acquire();
+			return _has_front ? &_buffers[_front].value : nullptr;
+		}
+
+		/* Draw the newest snapshot, edits are queued for the owner */
+		ImResponse input(const char* label, ImSettings& settings) {
+			/* Keep the same buffer while a value is dragged or typed */
+			if (!ImGui::IsAnyItemActive()) acquire();
+			flush_pending();
+
+			if (!_has_front) {
+				Detail::text_label(label);
+				ImGui::TextDisabled("Waiting for the owner to publish...");
+				return {};
+			}
+
+			buffer& front = _buffers[_front];
+			ImResponse response = Input(label, front.value, settings, *front.recorder);
+			if (front.recorder->edit_count() > 0 || response.get<T>().is_changed()) {
+				/*
+				* The buffer no longer matches its hashes, the owner copies everything into it next time.
+				* Also when a widget changed it without the recorder seeing it, so the change is dropped.
+				*/
+				front.edited.store(true, std::memory_order_release);
+			}
+			if (front.recorder->edit_count() > 0) {
+				_pending.push_back(front.recorder->log());
+				front.recorder->clear();
+				flush_pending();
+			}
+			return response;
+		}
+
+		ImResponse input(const char* label) {
+			ImSettings settings;
+			return input(label, settings);
+		}
+
+	private:
+		static constexpr std::uint8_t index_mask = 0x3;
+		static constexpr std::uint8_t fresh = 0x4; /* the ready buffer was published after the UI took its last one */
+
+		struct buffer {
+			T value{};
+			std::array<std::uint64_t, Detail::proxy_field_count<T>()> hashes{};
+			std::atomic<bool> edited{ false };
+			bool synced = false; /* hashes are valid, only touched by the owner */
+			std::unique_ptr<edit_recorder> recorder;
+		};
+
+		void acquire() {
+			if ((_ready.load(std::memory_order_relaxed) & fresh) == 0) return;
+			_front = _ready.exchange(_front, std::memory_order_acq_rel) & index_mask;
+			_has_front = true;
+		}
+
+		/* Move logs into the queue, the ones that don't fit wait for the next frame */
+		void flush_pending() {
+			while (!_pending.empty()) {
+				const std::size_t head = _head.load(std::memory_order_relaxed);
+				if (head - _tail.load(std::memory_order_acquire) == _queue.size()) return;
+				_queue[head % _queue.size()].swap(_pending.front());
+				_pending.pop_front();
+				_head.store(head + 1, std::memory_order_release);
+			}
+		}
+
+		std::array<buffer, 3> _buffers;
+		std::atomic<std::uint8_t> _ready{ 1 }; /* buffer handed over between the threads */
+		std::uint8_t _back = 0;                /* owner */
+		std::uint8_t _front = 2;               /* UI */
+		bool _has_front = false;
+		std::size_t _copied_fields = 0;
+
+		/* UI to owner, single producer single consumer */
+		std::vector<std::vector<unsigned char>> _queue;
+		alignas(64) std::atomic<std::size_t> _head{ 0 }; /* written by the UI */
+		alignas(64) std::atomic<std::size_t> _tail{ 0 }; /* written by the owner */
+		std::deque<std::vector<unsigned char>> _pending; /* UI only */
+	};
+}
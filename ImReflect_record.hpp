@@ -0,0 +1,725 @@
+#pragma once
+#include <imgui.h>
+
+#include "ImReflect_binary.hpp"
+#include "ImReflect_entry.hpp"
+#include "ImReflect_traits.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+/*
+* Record the edits made through ImReflect widgets and replay them later, without ImGui.
+*
+* Every change of a leaf is one record: the frame it happened on, the path from the root to
+* the leaf, the old and the new value. Edits that change a value as a whole (container insert,
+* erase, reorder, bulk operations, paste) are one record too, holding the old and the new value
+* of the whole container as a binary snapshot.
+* Paths are member and element indices, map entries are found by their key. A log replays onto
+* any object of the same type that starts out in the same state, e.g. one loaded from a
+* ``SaveBinary`` snapshot taken when recording started; with ``check_old`` replay stops at the
+* first edit whose old value doesn't match.
+* Changes of values that can't be read back from a snapshot (no default constructor) are logged
+* without a value, replaying one fails.
+*
+* Log layout, little overhead per edit:
+*	header: magic, version, schema hash of the root type
+*	edit:   varint frame delta, varint path length, varint steps..., leaf type tag (u32, 0 = not recorded),
+*	        varint old size, old bytes, varint new size, new bytes
+*	map entry steps: key size in bytes, key snapshot in u32 words, index among equal keys (multimaps)
+*
+* Example:
+*	static ImReflect::edit_recorder recorder(scene);
+*	ImReflect::Input("scene", scene, settings, recorder);
+*	recorder.save("edits.bin");
+*
+*	ImReflect::replay_result result = ImReflect::ReplayFile("edits.bin", fresh_scene);
+*/
+namespace ImReflect {
+
+	struct replay_result {
+		const char* error = nullptr; /* nullptr on success */
+		std::size_t offset = 0;      /* byte offset of the edit that failed */
+		std::size_t applied = 0;     /* edits applied */
+
+		explicit operator bool() const { return error == nullptr; }
+	};
+
+	namespace Detail {
+		inline constexpr std::uint32_t record_magic = 0x52524D49; /* "IMRR" */
+		inline constexpr std::uint32_t record_version = 2;
+
+		struct record_header {
+			std::uint32_t magic = record_magic;
+			std::uint32_t version = record_version;
+			std::uint64_t schema = 0;
+		};
+
+		inline void put_varint(std::vector<unsigned char>& out, std::uint64_t value) {
+			while (value >= 0x80) {
+				out.push_back(static_cast<unsigned char>(value | 0x80));
+				value >>= 7;
+			}
+			out.push_back(static_cast<unsigned char>(value));
+		}
+
+		inline bool get_varint(const unsigned char*& at, const unsigned char* end, std::uint64_t& value) {
+			value = 0;
+			for (int shift = 0; shift < 64 && at != end; shift += 7) {
+				const unsigned char byte = *at++;
+				value |= std::uint64_t(byte & 0x7F) << shift;
+				if ((byte & 0x80) == 0) return true;
+			}
+			return false;
+		}
+
+		/* Cheap check that a replayed leaf has the type it was recorded with */
+		template<typename T>
+		std::uint32_t leaf_tag() {
+			const std::uint64_t hash = binary_schema_hash<std::remove_cv_t<T>>();
+			return static_cast<std::uint32_t>(hash ^ (hash >> 32));
+		}
+
+		/* Tag of a change that couldn't be recorded */
+		inline constexpr std::uint32_t unrecorded_tag = 0;
+
+		inline std::vector<unsigned char>& replace_scratch() {
+			static thread_local std::vector<unsigned char> scratch;
+			return scratch;
+		}
+
+		/*
+		* Codec of a value that is replaced as a whole, nullptr when it can't be read back.
+		* Leaves use their journal codec, everything else a binary snapshot without header.
+		*/
+		template<typename T>
+		const journal_codec* replace_codec_of() {
+			using U = std::remove_cv_t<T>;
+			if constexpr (is_journaled_v<U>) {
+				return &journal_codec_of<U>();
+			} else if constexpr (is_binary_readable_v<U>) {
+				static const journal_codec codec{
+					[](const void* value) {
+						std::vector<unsigned char>& bytes = replace_scratch();
+						bytes.clear();
+						binary_writer(bytes).write(*static_cast<const U*>(value));
+						return bytes.size();
+					},
+					[](const void* value, unsigned char* out) {
+						std::vector<unsigned char>& bytes = replace_scratch();
+						bytes.clear();
+						binary_writer(bytes).write(*static_cast<const U*>(value));
+						std::memcpy(out, bytes.data(), bytes.size());
+					},
+					[](void* value, const unsigned char* data, std::size_t size) {
+						binary_reader reader(data, size);
+						reader.read(*static_cast<U*>(value));
+					}
+				};
+				return &codec;
+			} else {
+				return nullptr;
+			}
+		}
+
+		/* Iterator to element ``n`` of a range, ``end`` when there is none */
+		template<typename Range>
+		auto element_at(Range& range, std::size_t n) {
+			auto it = std::begin(range);
+			const auto end = std::end(range);
+			using category = typename std::iterator_traits<decltype(it)>::iterator_category;
+			if constexpr (std::is_base_of_v<std::random_access_iterator_tag, category>) {
+				return static_cast<std::size_t>(end - it) > n ? it + static_cast<std::ptrdiff_t>(n) : end;
+			} else {
+				for (; n > 0 && it != end; --n) ++it;
+				return it;
+			}
+		}
+
+		/*
+		* Path of the value at ``address`` inside an object, found by walking it.
+		* ``type`` tells a struct apart from its first member, nullptr finds a journaled leaf.
+		*/
+		struct record_locator {
+			const void* address;
+			const void* type;
+			std::vector<std::uint32_t>& path;
+			std::uint32_t tag = 0;
+
+			template<typename T>
+			bool contains(const T& value) const {
+				const unsigned char* begin = reinterpret_cast<const unsigned char*>(&value);
+				const unsigned char* target = static_cast<const unsigned char*>(address);
+				return !std::less<const unsigned char*>()(target, begin) && std::less<const unsigned char*>()(target, begin + sizeof(T));
+			}
+
+			template<typename T>
+			bool step(std::uint32_t index, T& value) {
+				path.push_back(index);
+				if (find(value)) return true;
+				path.pop_back();
+				return false;
+			}
+
+			template<typename T, std::size_t... I>
+			bool find_members(T& value, std::index_sequence<I...>) {
+				using ctx = visit_struct::context<ImContext>;
+				using U = std::remove_cv_t<T>;
+				return (step(static_cast<std::uint32_t>(I), value.*(ctx::get_pointer<static_cast<int>(I), U>())) || ...);
+			}
+
+			template<typename T, std::size_t... I>
+			bool find_tuple(T& value, std::index_sequence<I...>) {
+				return (step(static_cast<std::uint32_t>(I), std::get<I>(value)) || ...);
+			}
+
+			/* Steps of a map entry: key size, key snapshot, index among equal keys */
+			template<typename Map, typename It>
+			void insert_key_steps(std::size_t at, const Map& map, It entry) {
+				std::vector<unsigned char>& bytes = replace_scratch();
+				bytes.clear();
+				binary_writer(bytes).write(entry->first);
+				std::vector<std::uint32_t> steps(1 + (bytes.size() + 3) / 4, 0);
+				steps[0] = static_cast<std::uint32_t>(bytes.size());
+				if (!bytes.empty()) std::memcpy(steps.data() + 1, bytes.data(), bytes.size());
+				if constexpr (allows_duplicate_keys_v<Map>) {
+					steps.push_back(static_cast<std::uint32_t>(std::distance(map.equal_range(entry->first).first, typename Map::const_iterator(entry))));
+				}
+				path.insert(path.begin() + static_cast<std::ptrdiff_t>(at), steps.begin(), steps.end());
+			}
+
+			template<typename T>
+			bool find(T& value) {
+				using U = std::remove_cv_t<T>;
+				if (&value == address) {
+					if constexpr (is_journaled_v<T>) {
+						if (type == nullptr) {
+							tag = leaf_tag<U>();
+							return true;
+						}
+					}
+					if (type == type_tag_of<U>()) {
+						tag = leaf_tag<U>();
+						return true;
+					}
+				}
+				/* Nothing to follow outside of the object itself */
+				if constexpr (std::is_trivially_copyable_v<U>) {
+					if (!contains(value)) return false;
+				}
+
+				if constexpr (svh::is_tag_invocable_v<ImInput_t, const char*, T&, ImSettings&, ImResponse&>) {
+					return false; /* drawn as a whole by a user widget */
+				} else if constexpr (is_reflected_v<U>) {
+					return find_members(value, std::make_index_sequence<visit_struct::context<ImContext>::field_count<U>()>{});
+				} else if constexpr (is_map_like_v<U>) {
+					if constexpr (is_binary_creatable<typename U::key_type>()) {
+						/* Keys are only written into the path once the entry is found */
+						for (auto it = value.begin(); it != value.end(); ++it) {
+							const std::size_t at = path.size();
+							if (find(it->second)) {
+								insert_key_steps(at, value, it);
+								return true;
+							}
+						}
+					}
+					return false;
+				} else if constexpr (is_set_like_v<U>) {
+					return false; /* keys can't be edited in place */
+				} else if constexpr (is_range_v<U>) {
+					std::uint32_t i = 0;
+					for (auto&& element : value) {
+						if (step(i++, element)) return true;
+					}
+					return false;
+				} else if constexpr (is_tuple_like_v<U>) {
+					return find_tuple(value, std::make_index_sequence<std::tuple_size_v<U>>{});
+				} else if constexpr (is_optional_v<U>) {
+					return value.has_value() && step(0, *value);
+				} else if constexpr (is_variant_v<U>) {
+					if (value.valueless_by_exception()) return false;
+					const auto index = static_cast<std::uint32_t>(value.index());
+					return std::visit([&](auto& alternative) { return step(index, alternative); }, value);
+				} else if constexpr (is_smart_pointer_v<U>) {
+					if constexpr (std::is_same_v<U, std::weak_ptr<typename U::element_type>>) return false;
+					else return value && step(0, *value);
+				} else {
+					return false;
+				}
+			}
+		};
+
+		/* The value a recorded path leads to, nullptr when the object has a different shape */
+		struct record_resolver {
+			const std::uint32_t* steps;
+			std::size_t count;
+			std::uint32_t tag;
+			const journal_codec* codec = nullptr;
+			const void* type = nullptr;
+
+			template<typename Map>
+			void* resolve_entry(Map& map, std::uint32_t key_size) {
+				using K = typename Map::key_type;
+				if constexpr (is_binary_creatable<K>()) {
+					const std::size_t words = (std::size_t(key_size) + 3) / 4;
+					if (count < words) return nullptr;
+					K key{};
+					binary_reader reader(steps, key_size);
+					if (!reader.read(key) || reader.remaining() != 0) return nullptr;
+					steps += words;
+					count -= words;
+
+					if constexpr (allows_duplicate_keys_v<Map>) {
+						if (count == 0) return nullptr;
+						std::uint32_t duplicate = *steps++;
+						--count;
+						auto [it, last] = map.equal_range(key);
+						for (; duplicate > 0 && it != last; --duplicate) ++it;
+						return it == last ? nullptr : resolve(it->second);
+					} else {
+						const auto it = map.find(key);
+						return it == map.end() ? nullptr : resolve(it->second);
+					}
+				} else {
+					return nullptr;
+				}
+			}
+
+			template<typename T, std::size_t... I>
+			void* resolve_member(T& value, std::uint32_t index, std::index_sequence<I...>) {
+				using ctx = visit_struct::context<ImContext>;
+				using U = std::remove_cv_t<T>;
+				void* result = nullptr;
+				((I == index ? (result = resolve(value.*(ctx::get_pointer<static_cast<int>(I), U>())), true) : false) || ...);
+				return result;
+			}
+
+			template<typename T, std::size_t... I>
+			void* resolve_tuple(T& value, std::uint32_t index, std::index_sequence<I...>) {
+				void* result = nullptr;
+				((I == index ? (result = resolve(std::get<I>(value)), true) : false) || ...);
+				return result;
+			}
+
+			template<typename T>
+			void* resolve(T& value) {
+				using U = std::remove_cv_t<T>;
+				if (count == 0) {
+					if constexpr (!std::is_const_v<T>) {
+						if (leaf_tag<U>() == tag) {
+							codec = replace_codec_of<U>();
+							type = type_tag_of<U>();
+							return codec ? &value : nullptr;
+						}
+					}
+					return nullptr;
+				}
+
+				const std::uint32_t index = *steps++;
+				--count;
+				if constexpr (svh::is_tag_invocable_v<ImInput_t, const char*, T&, ImSettings&, ImResponse&>) {
+					return nullptr;
+				} else if constexpr (is_reflected_v<U>) {
+					return resolve_member(value, index, std::make_index_sequence<visit_struct::context<ImContext>::field_count<U>()>{});
+				} else if constexpr (is_map_like_v<U>) {
+					return resolve_entry(value, index);
+				} else if constexpr (is_set_like_v<U>) {
+					return nullptr;
+				} else if constexpr (is_range_v<U>) {
+					const auto it = element_at(value, index);
+					if (it == std::end(value)) return nullptr;
+					if constexpr (std::is_lvalue_reference_v<decltype(*it)>) {
+						return resolve(*it);
+					} else {
+						return nullptr; /* proxy references, std::vector<bool> */
+					}
+				} else if constexpr (is_tuple_like_v<U>) {
+					return resolve_tuple(value, index, std::make_index_sequence<std::tuple_size_v<U>>{});
+				} else if constexpr (is_optional_v<U>) {
+					return index == 0 && value.has_value() ? resolve(*value) : nullptr;
+				} else if constexpr (is_variant_v<U>) {
+					if (value.valueless_by_exception() || value.index() != index) return nullptr;
+					return std::visit([&](auto& alternative) { return resolve(alternative); }, value);
+				} else if constexpr (is_smart_pointer_v<U>) {
+					if constexpr (std::is_same_v<U, std::weak_ptr<typename U::element_type>>) return nullptr;
+					else return index == 0 && value ? resolve(*value) : nullptr;
+				} else {
+					return nullptr;
+				}
+			}
+		};
+
+		template<typename T>
+		bool locate_leaf(void* root, const void* address, const void* type, std::vector<std::uint32_t>& path, std::uint32_t& tag) {
+			record_locator locator{ address, type, path };
+			if (!locator.find(*static_cast<T*>(root))) return false;
+			tag = locator.tag;
+			return true;
+		}
+
+		/* Where a path leads now */
+		struct record_target {
+			void* address = nullptr;
+			const journal_codec* codec = nullptr;
+			const void* type = nullptr;
+		};
+
+		template<typename T>
+		record_target resolve_leaf(void* root, const std::uint32_t* steps, std::size_t count, std::uint32_t tag) {
+			record_resolver resolver{ steps, count, tag };
+			void* leaf = resolver.resolve(*static_cast<T*>(root));
+			if (leaf == nullptr) return {};
+			return { leaf, resolver.codec, resolver.type };
+		}
+
+		/*
+		* Reports a change of ``value`` as a whole (insert, erase, reorder, bulk operation, paste) to the
+		* active journal. ``capture()`` right before the first change saves the old value, the journal
+		* hears of it when the scope ends. Nothing is saved while no journal is active.
+		*/
+		template<typename T>
+		class scope_replace {
+		public:
+			scope_replace(const char* label, T& value) : _label(label), _value(value), _journal(active_journal()) {}
+			scope_replace(const scope_replace&) = delete;
+			scope_replace& operator=(const scope_replace&) = delete;
+
+			~scope_replace() {
+				if (_captured) _journal->on_replace(_label, const_cast<std::remove_const_t<T>*>(&_value), type_tag_of<T>(), _codec, _before.data(), _before.size());
+			}
+
+			void capture() {
+				if (_journal == nullptr || _captured) return;
+				_captured = true;
+				if (_codec == nullptr) return;
+				_before.resize(_codec->size(&_value));
+				if (!_before.empty()) _codec->save(&_value, _before.data());
+			}
+
+		private:
+			const char* _label;
+			T& _value;
+			edit_journal* const _journal;
+			const journal_codec* const _codec = std::is_const_v<T> ? nullptr : replace_codec_of<std::remove_const_t<T>>();
+			std::vector<unsigned char> _before;
+			bool _captured = false;
+		};
+	}
+
+	/*
+	* Journal that appends every change of a leaf below ``root`` to a binary log.
+	* Edits outside of ``root`` are ignored. Forwards to the journal that was active before it,
+	* so recording and ``undo_journal`` can be used together.
+	*/
+	class edit_recorder : public Detail::edit_journal {
+	public:
+		template<typename T>
+		explicit edit_recorder(T& root)
+			: _root(const_cast<std::remove_const_t<T>*>(&root)), _locate(&Detail::locate_leaf<std::remove_const_t<T>>),
+			_schema(binary_schema_hash<std::remove_const_t<T>>()) {
+			clear();
+		}
+
+		edit_recorder(const edit_recorder&) = delete;
+		edit_recorder& operator=(const edit_recorder&) = delete;
+
+		/* The log, ready to be saved or replayed */
+		const std::vector<unsigned char>& log() const { return _log; }
+		std::size_t edit_count() const { return _edits; }
+		/* Changes logged without a value, a replay fails on them */
+		std::size_t unrecorded_count() const { return _unrecorded; }
+
+		void clear() {
+			_log.clear();
+			Detail::record_header header;
+			header.schema = _schema;
+			_log.resize(sizeof(header));
+			std::memcpy(_log.data(), &header, sizeof(header));
+			_edits = 0;
+			_unrecorded = 0;
+			_last_frame = -1;
+			_cached_address = nullptr;
+		}
+
+		bool save(const char* path) const {
+			std::FILE* file = std::fopen(path, "wb");
+			if (file == nullptr) return false;
+			const bool written = std::fwrite(_log.data(), 1, _log.size(), file) == _log.size();
+			return std::fclose(file) == 0 && written;
+		}
+
+		void on_leaf(const char* label, void* address, const Detail::journal_codec& codec, const void* before, bool changed, bool active, bool finished) override {
+			if (_next) _next->on_leaf(label, address, codec, before, changed, active, finished);
+
+			if (changed) {
+				/* A drag reports the same leaf every frame, only look its path up once */
+				if (address != _cached_address) {
+					_cached_path.clear();
+					if (!_locate(_root, address, nullptr, _cached_path, _cached_tag)) return;
+					_cached_address = address;
+				}
+				record(address, codec, before);
+			} else if (active && before == nullptr) {
+				/* Strings don't pass their old value, keep it from before the first change */
+				save_value(_string_before, address, codec);
+				_string_address = address;
+			}
+
+			/* Containers may change shape between gestures, paths are looked up again */
+			if (finished || !active) _cached_address = nullptr;
+		}
+
+		void on_replace(const char* label, void* address, const void* type, const Detail::journal_codec* codec, const unsigned char* before, std::size_t before_size) override {
+			if (_next) _next->on_replace(label, address, type, codec, before, before_size);
+
+			/* Leaves below may have moved */
+			_cached_address = nullptr;
+			_string_address = nullptr;
+
+			_cached_path.clear();
+			if (!_locate(_root, address, type, _cached_path, _cached_tag)) return;
+			if (codec == nullptr) {
+				_old.clear();
+				_new.clear();
+				_cached_tag = Detail::unrecorded_tag;
+				++_unrecorded;
+			} else {
+				_old.assign(before, before + before_size);
+				save_value(_new, address, *codec);
+			}
+			write_record();
+		}
+
+		bool take_applied(const void* address, const void* type) override {
+			return _next != nullptr && _next->take_applied(address, type);
+		}
+
+	private:
+		friend struct scope_recorder;
+
+		static void save_value(std::vector<unsigned char>& out, const void* value, const Detail::journal_codec& codec) {
+			out.resize(codec.size(value));
+			if (!out.empty()) codec.save(value, out.data());
+		}
+
+		void put_bytes(const std::vector<unsigned char>& bytes) {
+			Detail::put_varint(_log, bytes.size());
+			_log.insert(_log.end(), bytes.begin(), bytes.end());
+		}
+
+		void record(void* address, const Detail::journal_codec& codec, const void* before) {
+			if (before != nullptr) {
+				save_value(_old, before, codec);
+			} else if (_string_address == address) {
+				_old.swap(_string_before);
+			} else {
+				_old.clear();
+			}
+			save_value(_new, address, codec);
+			if (before == nullptr) {
+				_string_before = _new;
+				_string_address = address;
+			}
+			write_record();
+		}
+
+		/* Append ``_cached_path``, ``_cached_tag``, ``_old`` and ``_new`` as one edit */
+		void write_record() {
+			const int frame = ImGui::GetFrameCount();
+			Detail::put_varint(_log, _last_frame < 0 ? 0 : static_cast<std::uint64_t>(frame - _last_frame));
+			_last_frame = frame;
+
+			Detail::put_varint(_log, _cached_path.size());
+			for (const std::uint32_t step : _cached_path) Detail::put_varint(_log, step);
+			const std::size_t at = _log.size();
+			_log.resize(at + sizeof(_cached_tag));
+			std::memcpy(_log.data() + at, &_cached_tag, sizeof(_cached_tag));
+			put_bytes(_old);
+			put_bytes(_new);
+			++_edits;
+		}
+
+		void* _root;
+		bool(*_locate)(void*, const void*, const void*, std::vector<std::uint32_t>&, std::uint32_t&);
+		std::uint64_t _schema;
+		Detail::edit_journal* _next = nullptr;
+
+		std::vector<unsigned char> _log;
+		std::size_t _edits = 0;
+		std::size_t _unrecorded = 0;
+		int _last_frame = -1;
+
+		const void* _cached_address = nullptr; /* leaf of the current gesture */
+		std::vector<std::uint32_t> _cached_path;
+		std::uint32_t _cached_tag = 0;
+
+		const void* _string_address = nullptr;
+		std::vector<unsigned char> _string_before;
+		std::vector<unsigned char> _old, _new; /* scratch, reused between edits */
+	};
+
+	/* While alive, edits made through ImReflect widgets are recorded in ``recorder`` */
+	struct scope_recorder {
+		edit_recorder& recorder;
+		Detail::edit_journal* const previous;
+		scope_recorder(edit_recorder& recorder) : recorder(recorder), previous(Detail::active_journal()) {
+			recorder._next = previous;
+			Detail::active_journal() = &recorder;
+		}
+		~scope_recorder() {
+			Detail::active_journal() = previous;
+			recorder._next = nullptr;
+		}
+	};
+
+	/* Record edits made to ``value`` */
+	template<typename T>
+	ImResponse Input(const char* label, T& value, ImSettings& settings, edit_recorder& recorder) {
+		const scope_recorder scope(recorder);
+		ImResponse response;
+		Detail::InputImpl(label, value, settings, response);
+		return response;
+	}
+
+	template<typename T>
+	ImResponse Input(const char* label, T& value, edit_recorder& recorder) {
+		ImSettings settings;
+		return Input(label, value, settings, recorder);
+	}
+
+	/*
+	* Applies a recorded log one edit at a time, needs no ImGui context.
+	* With ``check_old`` an edit fails when the value (leaf or whole container) doesn't hold the
+	* recorded old value, which is where a replay starts to diverge from the recording.
+	*/
+	class edit_replayer {
+	public:
+		edit_replayer(const void* data, std::size_t size)
+			: _begin(static_cast<const unsigned char*>(data)), _at(_begin), _end(_begin + size) {
+			if (size < sizeof(Detail::record_header)) {
+				fail("not an ImReflect edit log");
+				return;
+			}
+			std::memcpy(&_header, _begin, sizeof(_header));
+			if (_header.magic != Detail::record_magic) {
+				fail("not an ImReflect edit log");
+			} else if (_header.version != Detail::record_version) {
+				fail("unsupported edit log version");
+			}
+			_at += sizeof(_header);
+		}
+
+		edit_replayer& check_old(bool check) { _check_old = check; return *this; }
+
+		bool done() const { return _result.error != nullptr || _at == _end; }
+		const replay_result& result() const { return _result; }
+		/* Frame of the last applied edit, counted from the first edit */
+		std::uint64_t frame() const { return _frame; }
+
+		/* Apply the next edit, false when there is none or it failed */
+		template<typename T>
+		bool step(T& value) {
+			if (done()) return false;
+			if (_header.schema != binary_schema_hash<std::remove_const_t<T>>()) return fail("edit log was recorded for a different type layout");
+
+			const unsigned char* const start = _at;
+			std::uint64_t frame_delta = 0, steps = 0;
+			if (!Detail::get_varint(_at, _end, frame_delta) || !Detail::get_varint(_at, _end, steps)) return fail("unexpected end of edit log", start);
+			if (steps > static_cast<std::uint64_t>(_end - _at)) return fail("corrupt path length", start);
+
+			_path.resize(static_cast<std::size_t>(steps));
+			for (std::uint32_t& s : _path) {
+				std::uint64_t v = 0;
+				if (!Detail::get_varint(_at, _end, v)) return fail("unexpected end of edit log", start);
+				s = static_cast<std::uint32_t>(v);
+			}
+
+			std::uint32_t tag = 0;
+			const unsigned char *old_bytes = nullptr, *new_bytes = nullptr;
+			std::uint64_t old_size = 0, new_size = 0;
+			if (!read_tag(tag) || !read_bytes(old_bytes, old_size) || !read_bytes(new_bytes, new_size)) return fail("unexpected end of edit log", start);
+
+			if (tag == Detail::unrecorded_tag) return fail("edit of a value that couldn't be recorded", start);
+			Detail::record_resolver resolver{ _path.data(), _path.size(), tag };
+			void* leaf = resolver.resolve(value);
+			if (leaf == nullptr) return fail("path doesn't lead to a value of the recorded type", start);
+
+			const Detail::journal_codec& codec = *resolver.codec;
+			if (_check_old) {
+				_scratch.resize(codec.size(leaf));
+				if (!_scratch.empty()) codec.save(leaf, _scratch.data());
+				if (_scratch.size() != old_size || (old_size != 0 && std::memcmp(_scratch.data(), old_bytes, old_size) != 0)) {
+					return fail("value doesn't hold the recorded old value", start);
+				}
+			}
+			codec.load(leaf, new_bytes, static_cast<std::size_t>(new_size));
+
+			_frame += frame_delta;
+			++_result.applied;
+			return true;
+		}
+
+	private:
+		bool fail(const char* error, const unsigned char* at = nullptr) {
+			if (_result.error == nullptr) {
+				_result.error = error;
+				_result.offset = static_cast<std::size_t>((at ? at : _at) - _begin);
+			}
+			return false;
+		}
+
+		bool read_tag(std::uint32_t& tag) {
+			if (static_cast<std::size_t>(_end - _at) < sizeof(tag)) return false;
+			std::memcpy(&tag, _at, sizeof(tag));
+			_at += sizeof(tag);
+			return true;
+		}
+
+		bool read_bytes(const unsigned char*& bytes, std::uint64_t& size) {
+			if (!Detail::get_varint(_at, _end, size) || size > static_cast<std::uint64_t>(_end - _at)) return false;
+			bytes = _at;
+			_at += size;
+			return true;
+		}
+
+		const unsigned char* _begin;
+		const unsigned char* _at;
+		const unsigned char* _end;
+		Detail::record_header _header;
+		replay_result _result;
+		std::uint64_t _frame = 0;
+		bool _check_old = true;
+
+		std::vector<std::uint32_t> _path;
+		std::vector<unsigned char> _scratch;
+	};
+
+	/* Apply every edit of a log to ``value`` */
+	template<typename T>
+	replay_result Replay(const void* data, std::size_t size, T& value, bool check_old = true) {
+		edit_replayer replayer(data, size);
+		replayer.check_old(check_old);
+		while (replayer.step(value)) {}
+		return replayer.result();
+	}
+
+	template<typename T>
+	replay_result Replay(const std::vector<unsigned char>& log, T& value, bool check_old = true) {
+		return Replay(log.data(), log.size(), value, check_old);
+	}
+
+	template<typename T>
+	replay_result ReplayFile(const char* path, T& value, bool check_old = true) {
+		mapped_file file(path);
+		if (!file.is_open()) return { "can't open file", 0, 0 };
+		return Replay(file.data(), file.size(), value, check_old);
+	}
+}
@@ -0,0 +1,546 @@
+#pragma once
+#include <imgui.h>
+
+#include "ImReflect_binary.hpp"
+#include "ImReflect_entry.hpp"
+#include "ImReflect_helper.hpp"
+#include "ImReflect_record.hpp"
+
+/*
+* Inspect and edit the reflected state of another process over a Unix domain socket.
+*
+* The server runs in the process without a UI. Every ``tick()`` it takes a binary snapshot of
+* each registered root and sends the blocks that changed since the last tick, so large objects
+* that change sparsely cost little bandwidth. New clients get a full snapshot first.
+* The client keeps a mirror of every root, draws it with the usual widgets and sends the edits
+* back as an edit log (see ImReflect_record.hpp), which the server replays onto the real root.
+* Container inserts, removals, bulk operations and memory view writes are part of the log; a
+* change the log can't carry is reverted on the mirror.
+*
+* Both sides must be built with the same types, the snapshot schema hash is checked.
+* Only available where Unix domain sockets are (Linux, macOS, BSDs).
+*
+* Example:
+*	// Server
+*	ImReflect::remote_server server;
+*	server.add("world", world).listen("/tmp/game.sock");
+*	while (running) { simulate(); server.tick(); }
+*
+*	// Client
+*	ImReflect::remote_client client;
+*	client.add<world_state>("world").connect("/tmp/game.sock");
+*	client.poll(); // every frame
+*	client.input<world_state>("world", settings);
+*/
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace ImReflect {
+
+	namespace Detail {
+		enum class remote_message : std::uint8_t {
+			snapshot = 1, /* name, whole snapshot */
+			delta = 2,    /* name, snapshot size, runs of (offset, size, bytes) */
+			edits = 3,    /* name, edit log */
+		};
+
+		/* Snapshots are compared in blocks, adjacent changed blocks are sent as one run */
+		inline constexpr std::size_t remote_block_size = 64;
+		/* Frames larger than this are treated as a broken connection */
+		inline constexpr std::uint32_t remote_max_frame = 1u << 30;
+		/* Above this much unsent data a client gets a full snapshot once it catches up */
+		inline constexpr std::size_t remote_max_backlog = 16u << 20;
+
+		inline bool remote_address(const char* path, sockaddr_un& address) {
+			std::memset(&address, 0, sizeof(address));
+			address.sun_family = AF_UNIX;
+			const std::size_t length = std::strlen(path);
+			if (length == 0 || length >= sizeof(address.sun_path)) return false;
+			std::memcpy(address.sun_path, path, length);
+			return true;
+		}
+
+		inline void remote_configure(int fd) {
+			fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+#ifdef SO_NOSIGPIPE
+			int one = 1;
+			setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &one, sizeof(one));
+#endif
+		}
+
+		/* Append the frame header, returns where the frame starts for ``end_remote_frame`` */
+		inline std::size_t begin_remote_frame(std::vector<unsigned char>& out, remote_message kind, std::string_view name) {
+			const std::size_t start = out.size();
+			out.resize(start + sizeof(std::uint32_t));
+			out.push_back(static_cast<unsigned char>(kind));
+			put_varint(out, name.size());
+			out.insert(out.end(), name.begin(), name.end());
+			return start;
+		}
+
+		inline void end_remote_frame(std::vector<unsigned char>& out, std::size_t start) {
+			const std::uint32_t size = static_cast<std::uint32_t>(out.size() - start - sizeof(std::uint32_t));
+			std::memcpy(out.data() + start, &size, sizeof(size));
+		}
+
+		/* A non-blocking socket with framed messages: u32 size, u8 kind, payload */
+		class remote_connection {
+		public:
+			explicit remote_connection(int fd = -1) : _fd(fd) {}
+			~remote_connection() { close(); }
+
+			remote_connection(const remote_connection&) = delete;
+			remote_connection& operator=(const remote_connection&) = delete;
+
+			bool is_open() const { return _fd >= 0; }
+			std::size_t backlog() const { return _out.size() - _sent; }
+
+			void close() {
+				if (_fd >= 0) ::close(_fd);
+				_fd = -1;
+				_in.clear();
+				_out.clear();
+				_sent = 0;
+			}
+
+			/* Queue encoded frames, sent by ``flush()`` */
+			void send(const std::vector<unsigned char>& frames) {
+				_out.insert(_out.end(), frames.begin(), frames.end());
+			}
+
+			/* Send what the socket takes without blocking, false when the connection broke */
+			bool flush() {
+				while (_fd >= 0 && _sent < _out.size()) {
+#ifdef MSG_NOSIGNAL
+					const ssize_t sent = ::send(_fd, _out.data() + _sent, _out.size() - _sent, MSG_NOSIGNAL);
+#else
+					const ssize_t sent = ::send(_fd, _out.data() + _sent, _out.size() - _sent, 0);
+#endif
+					if (sent < 0) {
+						if (errno == EINTR) continue;
+						if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+						close();
+						return false;
+					}
+					_sent += static_cast<std::size_t>(sent);
+				}
+				if (_sent == _out.size()) {
+					_out.clear();
+					_sent = 0;
+				}
+				return _fd >= 0;
+			}
+
+			/* Read what is available and call ``handle(kind, name, payload, size)`` per complete frame */
+			template<typename Handler>
+			bool receive(Handler&& handle) {
+				unsigned char buffer[64 * 1024];
+				while (_fd >= 0) {
+					const ssize_t received = ::recv(_fd, buffer, sizeof(buffer), 0);
+					if (received > 0) {
+						_in.insert(_in.end(), buffer, buffer + received);
+						continue;
+					}
+					if (received < 0 && errno == EINTR) continue;
+					if (received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) break;
+					close(); /* closed by the peer or failed */
+					return false;
+				}
+
+				std::size_t at = 0;
+				while (_in.size() - at >= sizeof(std::uint32_t) + 1) {
+					std::uint32_t size = 0;
+					std::memcpy(&size, _in.data() + at, sizeof(size));
+					if (size == 0 || size > remote_max_frame) {
+						close();
+						return false;
+					}
+					if (_in.size() - at - sizeof(size) < size) break;
+
+					const unsigned char* frame = _in.data() + at + sizeof(size);
+					const unsigned char* const end = frame + size;
+					const auto kind = static_cast<remote_message>(*frame++);
+					std::uint64_t name_size = 0;
+					if (!get_varint(frame, end, name_size) || name_size > static_cast<std::uint64_t>(end - frame)) {
+						close();
+						return false;
+					}
+					const std::string_view name(reinterpret_cast<const char*>(frame), static_cast<std::size_t>(name_size));
+					frame += name_size;
+					handle(kind, name, frame, static_cast<std::size_t>(end - frame));
+					at += sizeof(size) + size;
+				}
+				_in.erase(_in.begin(), _in.begin() + static_cast<std::ptrdiff_t>(at));
+				return _fd >= 0;
+			}
+
+		private:
+			int _fd;
+			std::vector<unsigned char> _in;
+			std::vector<unsigned char> _out;
+			std::size_t _sent = 0;
+		};
+	}
+
+	/* Serves registered roots to any number of ``remote_client``s */
+	class remote_server {
+	public:
+		remote_server() = default;
+		~remote_server() { close(); }
+
+		remote_server(const remote_server&) = delete;
+		remote_server& operator=(const remote_server&) = delete;
+
+		/* Register a root, it must outlive the server */
+		template<typename T>
+		remote_server& add(const char* name, T& root) {
+			auto entry = std::make_unique<root_entry>();
+			entry->name = name;
+			entry->root = const_cast<std::remove_const_t<T>*>(&root);
+			entry->write = [](const void* root, std::vector<unsigned char>& out) {
+				WriteBinary(*static_cast<const T*>(root), out);
+			};
+			entry->apply = [](void* root, const unsigned char* log, std::size_t size) {
+				if constexpr (!std::is_const_v<T>) {
+					/* The root kept changing while the client edited, don't insist on old values */
+					return static_cast<bool>(Replay(log, size, *static_cast<T*>(root), false));
+				} else {
+					return false;
+				}
+			};
+			_roots.push_back(std::move(entry));
+			return *this;
+		}
+
+		/* Listen on a socket file, an existing file at ``path`` is replaced */
+		bool listen(const char* path) {
+			close();
+			sockaddr_un address;
+			if (!Detail::remote_address(path, address)) return false;
+			_fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+			if (_fd < 0) return false;
+			::unlink(path);
+			if (::bind(_fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0 || ::listen(_fd, 8) != 0) {
+				close();
+				return false;
+			}
+			Detail::remote_configure(_fd);
+			_path = path;
+			return true;
+		}
+
+		void close() {
+			_clients.clear();
+			if (_fd >= 0) ::close(_fd);
+			_fd = -1;
+			if (!_path.empty()) ::unlink(_path.c_str());
+			_path.clear();
+		}
+
+		bool is_listening() const { return _fd >= 0; }
+		std::size_t client_count() const { return _clients.size(); }
+
+		/* Accept clients, apply their edits and send what changed. Never blocks. */
+		void tick() {
+			if (_fd < 0) return;
+			accept_clients();
+
+			for (auto& client : _clients) {
+				client->connection.receive([&](Detail::remote_message kind, std::string_view name, const unsigned char* data, std::size_t size) {
+					if (kind != Detail::remote_message::edits) return;
+					if (root_entry* root = find(name)) root->apply(root->root, data, size);
+					});
+			}
+
+			_deltas.clear();
+			for (auto& root : _roots) {
+				root->current.clear();
+				root->write(root->root, root->current);
+				encode_delta(*root);
+				root->previous.swap(root->current);
+			}
+
+			_snapshots.clear();
+			for (auto& client : _clients) {
+				Detail::remote_connection& connection = client->connection;
+				if (client->full_snapshot) {
+					/* Behind or new: wait for the backlog to drain, then send everything at once */
+					if (connection.backlog() == 0) {
+						if (_snapshots.empty()) encode_snapshots();
+						connection.send(_snapshots);
+						client->full_snapshot = false;
+					}
+				} else {
+					connection.send(_deltas);
+					if (connection.backlog() > Detail::remote_max_backlog) client->full_snapshot = true;
+				}
+				connection.flush();
+			}
+
+			_clients.erase(std::remove_if(_clients.begin(), _clients.end(),
+				[](const std::unique_ptr<client_entry>& client) { return !client->connection.is_open(); }), _clients.end());
+		}
+
+	private:
+		struct root_entry {
+			std::string name;
+			void* root = nullptr;
+			void(*write)(const void* root, std::vector<unsigned char>& out) = nullptr;
+			bool(*apply)(void* root, const unsigned char* log, std::size_t size) = nullptr;
+			std::vector<unsigned char> previous; /* snapshot of the last tick */
+			std::vector<unsigned char> current;
+		};
+
+		struct client_entry {
+			Detail::remote_connection connection;
+			bool full_snapshot = true;
+			explicit client_entry(int fd) : connection(fd) {}
+		};
+
+		root_entry* find(std::string_view name) {
+			for (auto& root : _roots) {
+				if (root->name == name) return root.get();
+			}
+			return nullptr;
+		}
+
+		void accept_clients() {
+			for (;;) {
+				const int fd = ::accept(_fd, nullptr, nullptr);
+				if (fd < 0) break;
+				Detail::remote_configure(fd);
+				_clients.push_back(std::make_unique<client_entry>(fd));
+			}
+		}
+
+		void encode_snapshots() {
+			for (auto& root : _roots) {
+				const std::size_t start = Detail::begin_remote_frame(_snapshots, Detail::remote_message::snapshot, root->name);
+				_snapshots.insert(_snapshots.end(), root->previous.begin(), root->previous.end());
+				Detail::end_remote_frame(_snapshots, start);
+			}
+		}
+
+		/* Changed blocks of ``current`` against ``previous``, appended to ``_deltas`` as one frame */
+		void encode_delta(root_entry& root) {
+			if (root.previous.empty()) return; /* first tick, clients get full snapshots */
+
+			std::vector<unsigned char>& out = _deltas;
+			const std::size_t start = Detail::begin_remote_frame(out, Detail::remote_message::delta, root.name);
+			Detail::put_varint(out, root.current.size());
+
+			const std::size_t size = root.current.size();
+			const std::size_t common = std::min(size, root.previous.size());
+			std::size_t runs = 0;
+			for (std::size_t block = 0; block < size;) {
+				const std::size_t length = std::min(Detail::remote_block_size, size - block);
+				const bool changed = block + length > common || std::memcmp(root.current.data() + block, root.previous.data() + block, length) != 0;
+				if (!changed) {
+					block += length;
+					continue;
+				}
+				std::size_t end = block + length;
+				while (end < size) {
+					const std::size_t next = std::min(Detail::remote_block_size, size - end);
+					if (end + next <= common && std::memcmp(root.current.data() + end, root.previous.data() + end, next) == 0) break;
+					end += next;
+				}
+				Detail::put_varint(out, block);
+				Detail::put_varint(out, end - block);
+				out.insert(out.end(), root.current.begin() + static_cast<std::ptrdiff_t>(block), root.current.begin() + static_cast<std::ptrdiff_t>(end));
+				++runs;
+				block = end;
+			}
+
+			if (runs > 0 || size != root.previous.size()) {
+				Detail::end_remote_frame(out, start);
+			} else {
+				out.resize(start); /* nothing changed */
+			}
+		}
+
+		int _fd = -1;
+		std::string _path;
+		std::vector<std::unique_ptr<root_entry>> _roots;
+		std::vector<std::unique_ptr<client_entry>> _clients;
+		std::vector<unsigned char> _deltas;    /* this tick's delta frames, sent to every client */
+		std::vector<unsigned char> _snapshots; /* full snapshot frames, built when a client needs them */
+	};
+
+	/* Mirrors the roots of a ``remote_server`` and sends edits back */
+	class remote_client {
+	public:
+		remote_client() = default;
+		~remote_client() { close(); }
+
+		remote_client(const remote_client&) = delete;
+		remote_client& operator=(const remote_client&) = delete;
+
+		/* Mirror the server root ``name``, which must have the same type */
+		template<typename T>
+		remote_client& add(const char* name) {
+			static_assert(std::is_default_constructible_v<T>, "ImReflect Error: remote roots must be default constructible on the client");
+			auto entry = std::make_unique<root_entry>();
+			auto object = std::make_shared<T>();
+			entry->name = name;
+			entry->schema = binary_schema_hash<T>();
+			entry->recorder = std::make_unique<edit_recorder>(*object);
+			entry->read = [](void* object, const std::vector<unsigned char>& snapshot) {
+				return static_cast<bool>(ReadBinary(snapshot.data(), snapshot.size(), *static_cast<T*>(object)));
+			};
+			entry->object = std::move(object);
+			_roots.push_back(std::move(entry));
+			return *this;
+		}
+
+		bool connect(const char* path) {
+			close();
+			sockaddr_un address;
+			if (!Detail::remote_address(path, address)) return false;
+			const int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+			if (fd < 0) return false;
+			if (::connect(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0) {
+				::close(fd);
+				return false;
+			}
+			Detail::remote_configure(fd);
+			_connection = std::make_unique<Detail::remote_connection>(fd);
+			return true;
+		}
+
+		void close() {
+			_connection.reset();
+			for (auto& root : _roots) {
+				root->snapshot.clear();
+				root->received = false;
+			}
+		}
+
+		bool is_connected() const { return _connection && _connection->is_open(); }
+
+		/* True once the first snapshot of ``name`` arrived */
+		bool has(std::string_view name) const {
+			const root_entry* root = find(name);
+			return root != nullptr && root->received;
+		}
+
+		/* Receive and apply updates, call once per frame */
+		void poll() {
+			if (!is_connected()) return;
+			_connection->receive([&](Detail::remote_message kind, std::string_view name, const unsigned char* data, std::size_t size) {
+				root_entry* root = find(name);
+				if (root == nullptr) return;
+				if (kind == Detail::remote_message::snapshot) {
+					root->snapshot.assign(data, data + size);
+					root->dirty = true;
+				} else if (kind == Detail::remote_message::delta && !root->snapshot.empty()) {
+					/* Patch the bytes even before they were read into the mirror, that waits for no active item */
+					root->dirty |= patch(*root, data, data + size);
+				}
+				});
+			_connection->flush();
+
+			/* Don't overwrite a value while it is being dragged or typed, the server hasn't seen the edit yet */
+			if (ImGui::GetCurrentContext() != nullptr && ImGui::IsAnyItemActive()) return;
+			for (auto& root : _roots) {
+				if (!root->dirty) continue;
+				root->dirty = false;
+				root->received = root->read(root->object.get(), root->snapshot);
+			}
+		}
+
+		/* Local mirror of ``name``, nullptr before the first snapshot */
+		template<typename T>
+		T* get(std::string_view name) {
+			root_entry* root = find(name);
+			if (root == nullptr || !root->received || root->schema != binary_schema_hash<T>()) return nullptr;
+			return static_cast<T*>(root->object.get());
+		}
+
+		/* Draw the mirror of ``name``, edits are sent to the server */
+		template<typename T>
+		ImResponse input(const char* name, ImSettings& settings) {
+			T* value = get<T>(name);
+			if (value == nullptr) {
+				Detail::text_label(name);
+				ImGui::TextDisabled(is_connected() ? "Waiting for the server..." : "Not connected");
+				return {};
+			}
+			root_entry& root = *find(name);
+			const ImResponse response = Input(name, *value, settings, *root.recorder);
+			if (root.recorder->unrecorded_count() > 0 || (root.recorder->edit_count() == 0 && response.get<T>().is_changed())) {
+				/* The server won't see this change, the mirror is read back from the last snapshot */
+				root.dirty = true;
+			}
+			if (root.recorder->edit_count() > 0) {
+				const std::vector<unsigned char>& log = root.recorder->log();
+				_frame.clear();
+				const std::size_t start = Detail::begin_remote_frame(_frame, Detail::remote_message::edits, root.name);
+				_frame.insert(_frame.end(), log.begin(), log.end());
+				Detail::end_remote_frame(_frame, start);
+				_connection->send(_frame);
+				_connection->flush();
+				root.recorder->clear();
+			}
+			return response;
+		}
+
+		template<typename T>
+		ImResponse input(const char* name) {
+			ImSettings settings;
+			return input<T>(name, settings);
+		}
+
+	private:
+		struct root_entry {
+			std::string name;
+			std::uint64_t schema = 0;
+			std::shared_ptr<void> object;
+			std::unique_ptr<edit_recorder> recorder;
+			bool(*read)(void* object, const std::vector<unsigned char>& snapshot) = nullptr;
+			std::vector<unsigned char> snapshot; /* latest snapshot of the server root */
+			bool received = false;
+			bool dirty = false;
+		};
+
+		root_entry* find(std::string_view name) const {
+			for (auto& root : _roots) {
+				if (root->name == name) return root.get();
+			}
+			return nullptr;
+		}
+
+		static bool patch(root_entry& root, const unsigned char* at, const unsigned char* end) {
+			std::uint64_t size = 0;
+			if (!Detail::get_varint(at, end, size)) return false;
+			root.snapshot.resize(static_cast<std::size_t>(size));
+			while (at != end) {
+				std::uint64_t offset = 0, length = 0;
+				if (!Detail::get_varint(at, end, offset) || !Detail::get_varint(at, end, length)) return false;
+				if (length > static_cast<std::uint64_t>(end - at) || offset + length > size) return false;
+				std::memcpy(root.snapshot.data() + offset, at, static_cast<std::size_t>(length));
+				at += length;
+			}
+			return true;
+		}
+
+		std::unique_ptr<Detail::remote_connection> _connection;
+		std::vector<std::unique_ptr<root_entry>> _roots;
+		std::vector<unsigned char> _frame; /* scratch for outgoing edits */
+	};
+}
+
+#endif
@@ -0,0 +1,587 @@
+#pragma once
+#include <imgui.h>
+#include <imgui_stdlib.h>
+
+#include "ImReflect_entry.hpp"
+#include "ImReflect_traits.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/*
+* Field path index for filtering big reflected objects.
+*
+* The index is a flat array of nodes (members, container elements, map entries), built
+* breadth first from a work list so it can be filled over several frames. Containers,
+* optionals, variants and smart pointers remember a cheap structural signature (size and
+* front address); when it changes only that subtree is thrown away and indexed again.
+* Erase + insert in a node based container can keep both, so after a frame whose response
+* reports a change those are also checked element by element.
+*
+* Example:
+*	static ImReflect::search_index index;
+*	ImReflect::SearchBox("##filter", index);
+*	ImReflect::Input("scene", scene, settings, index);
+*/
+namespace ImReflect {
+
+	class search_index : public Detail::field_filter {
+	public:
+		static constexpr std::uint32_t npos = static_cast<std::uint32_t>(-1);
+
+		search_index() = default;
+		search_index(const search_index&) = delete;
+		search_index& operator=(const search_index&) = delete;
+
+		/* (Re)build the index for a root object. Member labels are resolved with ``settings``, which must outlive the index. */
+		template<typename T>
+		void build(T& root, ImSettings& settings);
+
+		/* (Re)build the index for a root object with default settings */
+		template<typename T>
+		void build(T& root) {
+			if (!_owned_settings) _owned_settings = std::make_unique<ImSettings>();
+			build(root, *_owned_settings);
+		}
+
+		template<typename T>
+		bool is_built_for(const T& root, const ImSettings* settings = nullptr) const {
+			return _root == static_cast<const void*>(&root) &&
+				_root_type == Detail::type_tag_of<T>() &&
+				(settings == nullptr || settings == _settings);
+		}
+
+		/*
+		* Re-check structural signatures and expand pending nodes.
+		* ``max_nodes`` limits how many nodes are expanded in this call, 0 = no limit.
+		* Returns true when the index is complete.
+		*/
+		bool update(std::size_t max_nodes = 0);
+
+		/*
+		* Check node based containers (list, map, set...) element by element on the next ``update``.
+		* The ``Input`` overload calls it when its response reports a change; call it after erasing
+		* and inserting in such a container elsewhere.
+		*/
+		void elements_changed() { _check_elements = true; }
+
+		void clear();
+
+		/* Case insensitive substring filter, empty = everything visible */
+		void set_filter(std::string_view filter);
+		const std::string& get_filter() const { return _filter; }
+		bool has_filter() const { return !_filter_lower.empty(); }
+
+		/* Nodes expanded per frame by the ``ImReflect::Input`` overload, 0 = no limit */
+		search_index& nodes_per_frame(std::size_t count) { _nodes_per_frame = count; return *this; }
+		std::size_t get_nodes_per_frame() const { return _nodes_per_frame; }
+
+		bool is_complete() const { return _pending_cursor >= _pending.size(); }
+		std::size_t size() const { return _nodes.size() - _dead_count; }
+		std::size_t match_count() const { return _match_count; }
+
+		/* Fields that are not indexed (yet) are always visible */
+		bool is_visible(const void* address, const void* type) const override {
+			if (!has_filter()) return true;
+			const auto it = _visibility.find(key{ address, type });
+			return it == _visibility.end() || it->second;
+		}
+
+		/* Called by the type erased expand functions */
+		template<typename T>
+		void add_child(std::uint32_t parent, std::string_view name, const T& child, ImSettings* settings);
+
+	private:
+		struct key {
+			const void* address = nullptr;
+			const void* type = nullptr;
+			bool operator==(const key& other) const { return address == other.address && type == other.type; }
+		};
+
+		struct key_hash {
+			std::size_t operator()(const key& k) const {
+				const std::size_t a = std::hash<const void*>()(k.address);
+				return a ^ (std::hash<const void*>()(k.type) + 0x9e3779b97f4a7c15ull + (a << 6) + (a >> 2));
+			}
+		};
+
+		/* Cheap description of the shape of a node, if it changes the children are stale */
+		struct signature {
+			std::size_t size = 0;
+			std::uint64_t front = 0;
+			bool operator!=(const signature& other) const { return size != other.size || front != other.front; }
+		};
+
+		using expand_fn = void(*)(search_index&, std::uint32_t);
+		using signature_fn = signature(*)(const void*);
+		using element_hash_fn = std::uint64_t(*)(const void*);
+
+		struct node {
+			const void* address = nullptr;
+			const void* type = nullptr;
+			ImSettings* settings = nullptr;
+			std::uint32_t parent = npos;
+			std::uint32_t first_child = npos;
+			std::uint32_t child_count = 0;
+			std::uint32_t name_begin = 0;
+			std::uint32_t name_length = 0;
+			expand_fn expand = nullptr;
+			signature_fn get_signature = nullptr;
+			signature shape;
+			element_hash_fn get_element_hash = nullptr; /* node based containers only */
+			std::uint64_t element_hash = 0;
+			bool alive = true;
+			bool expanded = false;
+		};
+
+		template<typename T>
+		static void expand_node(search_index& index, std::uint32_t id);
+
+		template<typename T>
+		static signature signature_of(const void* address);
+
+		/* Hash of every element address, erase + insert can keep the size and the front */
+		template<typename T>
+		static std::uint64_t element_hash_of(const void* address);
+
+		/* vector, array, span, C arrays: element addresses follow from the front and the size */
+		template<typename T, typename = void>
+		struct has_data_impl : std::false_type {};
+		template<typename T>
+		struct has_data_impl<T, std::enable_if_t<std::is_pointer_v<decltype(std::data(std::declval<const T&>()))>>> : std::true_type {};
+
+		/* Ranges of proxies (std::vector<bool>) have no element addresses to index */
+		template<typename T>
+		static constexpr bool is_indexable_range_v = [] {
+			if constexpr (Detail::is_range_v<T>) {
+				return std::is_lvalue_reference_v<decltype(*std::begin(std::declval<const T&>()))>;
+			} else {
+				return false;
+			}
+		}();
+
+		template<typename T>
+		static constexpr bool has_children_v =
+			Detail::is_reflected_v<T> || is_indexable_range_v<T> || Detail::is_optional_v<T> ||
+			Detail::is_variant_v<T> || Detail::is_tuple_like_v<T> || Detail::is_smart_pointer_v<T>;
+
+		template<typename T>
+		static constexpr bool has_signature_v =
+			is_indexable_range_v<T> || Detail::is_optional_v<T> || Detail::is_variant_v<T> || Detail::is_smart_pointer_v<T>;
+
+		template<typename T>
+		static constexpr bool is_node_based_v = is_indexable_range_v<T> && !has_data_impl<T>::value;
+
+		template<typename T>
+		void track_shape(node& n, const T& value);
+
+		std::uint32_t push_node(std::uint32_t parent, std::string_view name);
+		void kill_children(std::uint32_t id);
+		void check_signatures();
+		void compact();
+		void rebuild_visibility();
+
+		const void* _root = nullptr;
+		const void* _root_type = nullptr;
+		ImSettings* _settings = nullptr;
+		std::unique_ptr<ImSettings> _owned_settings;
+
+		std::vector<node> _nodes;
+		std::string _names; /* lower case names of all nodes, nodes point into this */
+		std::vector<std::uint32_t> _pending;
+		std::size_t _pending_cursor = 0;
+		std::vector<std::uint32_t> _dynamic; /* nodes with a signature */
+		std::size_t _dead_count = 0;
+		std::size_t _nodes_per_frame = 0;
+
+		std::string _filter;
+		std::string _filter_lower;
+		std::unordered_map<key, bool, key_hash> _visibility;
+		std::size_t _match_count = 0;
+		bool _visibility_dirty = false;
+		bool _check_elements = false;
+	};
+
+	/* While alive, rendering skips fields hidden by the index filter */
+	struct scope_search {
+		Detail::field_filter* const previous;
+		scope_search(search_index& index) : previous(Detail::active_field_filter()) {
+			Detail::active_field_filter() = &index;
+		}
+		~scope_search() { Detail::active_field_filter() = previous; }
+	};
+}
+
+/* Implementation */
+namespace ImReflect {
+
+	template<typename T>
+	void search_index::build(T& root, ImSettings& settings) {
+		clear();
+		_root = &root;
+		_root_type = Detail::type_tag_of<T>();
+		_settings = &settings;
+
+		const std::uint32_t id = push_node(npos, {});
+		node& n = _nodes[id];
+		n.address = &root;
+		n.type = _root_type;
+		n.settings = &settings;
+		if constexpr (has_children_v<T>) {
+			n.expand = &expand_node<std::remove_cv_t<T>>;
+			_pending.push_back(id);
+		}
+		track_shape(n, root);
+		if constexpr (has_signature_v<T>) _dynamic.push_back(id);
+	}
+
+	template<typename T>
+	void search_index::track_shape(node& n, const T& value) {
+		using U = std::remove_cv_t<T>;
+		if constexpr (has_signature_v<U>) {
+			n.get_signature = &signature_of<U>;
+			n.shape = signature_of<U>(&value);
+		}
+		if constexpr (is_node_based_v<U>) {
+			n.get_element_hash = &element_hash_of<U>;
+			n.element_hash = element_hash_of<U>(&value);
+		}
+	}
+
+	template<typename T>
+	void search_index::add_child(std::uint32_t parent, std::string_view name, const T& child, ImSettings* settings) {
+		using U = std::remove_cv_t<T>;
+		const std::uint32_t id = push_node(parent, name);
+		node& n = _nodes[id];
+		n.address = &child;
+		n.type = Detail::type_tag_of<U>();
+		n.settings = settings;
+		if constexpr (has_children_v<U>) {
+			n.expand = &expand_node<U>;
+			_pending.push_back(id);
+		}
+		track_shape(n, child);
+		if constexpr (has_signature_v<U>) _dynamic.push_back(id);
+
+		node& p = _nodes[parent];
+		if (p.child_count == 0) p.first_child = id;
+		++p.child_count;
+	}
+
+	template<typename T>
+	search_index::signature search_index::signature_of(const void* address) {
+		const T& value = *static_cast<const T*>(address);
+		const auto address_of = [](const void* pointer) { return static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(pointer)); };
+		if constexpr (is_indexable_range_v<T> && has_data_impl<T>::value) {
+			return { Detail::range_size(value), address_of(std::data(value)) };
+		} else if constexpr (is_indexable_range_v<T>) {
+			/* forward_list has no size, counting it would visit every element */
+			const auto begin = std::begin(value);
+			const bool empty = begin == std::end(value);
+			std::size_t size = 0;
+			if constexpr (Detail::has_size_v<T>) size = static_cast<std::size_t>(value.size());
+			return { size, empty ? 0u : address_of(std::addressof(*begin)) };
+		} else if constexpr (Detail::is_optional_v<T>) {
+			return { value.has_value() ? 1u : 0u, value.has_value() ? address_of(&*value) : 0u };
+		} else if constexpr (Detail::is_variant_v<T>) {
+			return { value.index(), 0u };
+		} else if constexpr (Detail::is_smart_pointer_v<T>) {
+			if constexpr (std::is_same_v<T, std::weak_ptr<typename T::element_type>>) {
+				return { value.expired() ? 0u : 1u, 0u };
+			} else {
+				return { value ? 1u : 0u, address_of(value.get()) };
+			}
+		} else {
+			return {};
+		}
+	}
+
+	template<typename T>
+	std::uint64_t search_index::element_hash_of(const void* address) {
+		const T& value = *static_cast<const T*>(address);
+		std::uint64_t hash = 14695981039346656037ull;
+		for (const auto& element : value) {
+			hash = (hash ^ static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(std::addressof(element)))) * 1099511628211ull;
+		}
+		return hash;
+	}
+
+	template<typename T>
+	void search_index::expand_node(search_index& index, std::uint32_t id) {
+		const T& value = *static_cast<const T*>(index._nodes[id].address);
+		ImSettings* settings = index._nodes[id].settings;
+
+		/* Mirror the settings lookups done while rendering so labels match */
+		auto& type_settings = settings->get<T>();
+
+		if constexpr (Detail::is_reflected_v<T>) {
+			visit_struct::context<Detail::ImContext>::for_each(value,
+				[&](const char* name, const auto& field) {
+					auto& member_settings = type_settings.get_member(value, field);
+					std::string_view label = member_settings.has_label() ? std::string_view(member_settings.get_label()) : std::string_view(name);
+					label = label.substr(0, label.find("##"));
+					index.add_child(id, label, field, &member_settings);
+				});
+		} else if constexpr (Detail::is_map_like_v<T> && is_indexable_range_v<T>) {
+			std::string name;
+			std::size_t i = 0;
+			for (const auto& entry : value) {
+				name.clear();
+				if (!Detail::append_text(name, entry.first)) {
+					name = "[" + std::to_string(i) + "]";
+				}
+				index.add_child(id, name, entry.second, &type_settings);
+				++i;
+			}
+		} else if constexpr (is_indexable_range_v<T>) {
+			std::string name;
+			std::size_t i = 0;
+			for (const auto& element : value) {
+				name = "[" + std::to_string(i++) + "]";
+				index.add_child(id, name, element, &type_settings);
+			}
+		} else if constexpr (Detail::is_optional_v<T>) {
+			if (value.has_value()) index.add_child(id, {}, *value, &type_settings);
+		} else if constexpr (Detail::is_variant_v<T>) {
+			if (!value.valueless_by_exception()) {
+				std::visit([&](const auto& alternative) { index.add_child(id, {}, alternative, &type_settings); }, value);
+			}
+		} else if constexpr (Detail::is_tuple_like_v<T>) {
+			std::apply([&](const auto&... elements) { (index.add_child(id, {}, elements, &type_settings), ...); }, value);
+		} else if constexpr (Detail::is_smart_pointer_v<T>) {
+			/* weak pointers are not followed, the pointee is only borrowed while rendering */
+			if constexpr (!std::is_same_v<T, std::weak_ptr<typename T::element_type>>) {
+				if (value) index.add_child(id, {}, *value, &type_settings);
+			}
+		}
+	}
+
+	inline std::uint32_t search_index::push_node(std::uint32_t parent, std::string_view name) {
+		node n;
+		n.parent = parent;
+		n.name_begin = static_cast<std::uint32_t>(_names.size());
+		n.name_length = static_cast<std::uint32_t>(name.size());
+		for (const char c : name) {
+			_names.push_back(static_cast<char>(std::tolower(static_cast<unsigned char>(c))));
+		}
+		_nodes.push_back(n);
+		_visibility_dirty = true;
+		return static_cast<std::uint32_t>(_nodes.size() - 1);
+	}
+
+	inline void search_index::clear() {
+		_root = nullptr;
+		_root_type = nullptr;
+		_settings = nullptr;
+		_nodes.clear();
+		_names.clear();
+		_pending.clear();
+		_pending_cursor = 0;
+		_dynamic.clear();
+		_dead_count = 0;
+		_visibility.clear();
+		_match_count = 0;
+		_visibility_dirty = true;
+		_check_elements = false;
+	}
+
+	inline void search_index::kill_children(std::uint32_t id) {
+		node& n = _nodes[id];
+		const std::uint32_t first = n.first_child;
+		const std::uint32_t count = n.child_count;
+		n.first_child = npos;
+		n.child_count = 0;
+		n.expanded = false;
+		for (std::uint32_t i = 0; i < count; ++i) {
+			node& child = _nodes[first + i];
+			if (!child.alive) continue;
+			kill_children(first + i);
+			child.alive = false;
+			++_dead_count;
+		}
+	}
+
+	inline void search_index::check_signatures() {
+		/*
+		* Parents always have a lower index than their children, so a stale parent is handled before its children are touched.
+		* A node whose ancestor changed is dead by the time it is reached, its address is never read.
+		* Elements of node based containers are only visited after ``elements_changed()``.
+		*/
+		const bool check_elements = _check_elements;
+		_check_elements = false;
+		for (std::size_t i = 0; i < _dynamic.size(); ++i) {
+			const std::uint32_t id = _dynamic[i];
+			node& n = _nodes[id];
+			if (!n.alive) continue;
+
+			const signature current = n.get_signature(n.address);
+			bool stale = current != n.shape;
+			if (!stale && check_elements && n.get_element_hash) stale = n.get_element_hash(n.address) != n.element_hash;
+			if (stale) {
+				n.shape = current;
+				if (n.get_element_hash) n.element_hash = n.get_element_hash(n.address);
+				kill_children(id);
+				_pending.push_back(id);
+				_visibility_dirty = true;
+			}
+		}
+		_dynamic.erase(std::remove_if(_dynamic.begin(), _dynamic.end(), [&](std::uint32_t id) { return !_nodes[id].alive; }), _dynamic.end());
+	}
+
+	inline bool search_index::update(std::size_t max_nodes) {
+		if (_root == nullptr) return true;
+
+		check_signatures();
+
+		std::size_t expanded = 0;
+		while (_pending_cursor < _pending.size() && (max_nodes == 0 || expanded < max_nodes)) {
+			const std::uint32_t id = _pending[_pending_cursor++];
+			node& n = _nodes[id];
+			if (!n.alive || n.expanded) continue;
+			n.expanded = true;
+			n.expand(*this, id);
+			++expanded;
+		}
+
+		if (is_complete()) {
+			_pending.clear();
+			_pending_cursor = 0;
+			if (_dead_count > 1024 && _dead_count * 2 > _nodes.size()) {
+				compact();
+			}
+		}
+
+		if (_visibility_dirty) {
+			rebuild_visibility();
+		}
+		return is_complete();
+	}
+
+	inline void search_index::compact() {
+		std::vector<std::uint32_t> remap(_nodes.size(), npos);
+		std::vector<node> nodes;
+		std::string names;
+		nodes.reserve(_nodes.size() - _dead_count);
+		names.reserve(_names.size());
+
+		for (std::size_t i = 0; i < _nodes.size(); ++i) {
+			if (!_nodes[i].alive) continue;
+			remap[i] = static_cast<std::uint32_t>(nodes.size());
+			node n = _nodes[i];
+			const std::uint32_t name_begin = static_cast<std::uint32_t>(names.size());
+			names.append(_names, n.name_begin, n.name_length);
+			n.name_begin = name_begin;
+			nodes.push_back(n);
+		}
+		for (node& n : nodes) {
+			if (n.parent != npos) n.parent = remap[n.parent];
+			if (n.child_count > 0) n.first_child = remap[n.first_child];
+		}
+		for (std::uint32_t& id : _dynamic) {
+			id = remap[id];
+		}
+
+		_nodes = std::move(nodes);
+		_names = std::move(names);
+		_dead_count = 0;
+		_visibility_dirty = true;
+	}
+
+	inline void search_index::set_filter(std::string_view filter) {
+		if (filter == _filter) return;
+		_filter.assign(filter.data(), filter.size());
+		_filter_lower.clear();
+		for (const char c : filter) {
+			_filter_lower.push_back(static_cast<char>(std::tolower(static_cast<unsigned char>(c))));
+		}
+		_visibility_dirty = true;
+		rebuild_visibility();
+	}
+
+	inline void search_index::rebuild_visibility() {
+		_visibility_dirty = false;
+		_visibility.clear();
+		_match_count = 0;
+		if (!has_filter()) return;
+
+		/* Forward pass: a node is shown when it matches or lives inside a match. Children always follow their parent. */
+		std::vector<char> shown(_nodes.size(), 0);
+		for (std::size_t i = 0; i < _nodes.size(); ++i) {
+			const node& n = _nodes[i];
+			if (!n.alive) continue;
+			const std::string_view name(_names.data() + n.name_begin, n.name_length);
+			const bool match = name.find(_filter_lower) != std::string_view::npos;
+			if (match) ++_match_count;
+			shown[i] = match || (n.parent != npos && shown[n.parent]);
+		}
+
+		/* Backward pass: ancestors of shown nodes are shown */
+		for (std::size_t i = _nodes.size(); i-- > 0;) {
+			const node& n = _nodes[i];
+			if (shown[i] && n.parent != npos) shown[n.parent] = 1;
+		}
+
+		_visibility.reserve(_nodes.size() - _dead_count);
+		for (std::size_t i = 0; i < _nodes.size(); ++i) {
+			const node& n = _nodes[i];
+			if (!n.alive) continue;
+			/* Several nodes can share an address (pass through optionals), one visible node wins */
+			auto& visible = _visibility[key{ n.address, n.type }];
+			visible = visible || shown[i];
+		}
+	}
+
+	/* Filter text box for a search index, returns true when the filter changed */
+	inline bool SearchBox(const char* label, search_index& index, const char* hint = "Filter fields...") {
+		std::string filter = index.get_filter();
+		const bool changed = ImGui::InputTextWithHint(label, hint, &filter);
+		if (changed) {
+			index.set_filter(filter);
+		}
+		if (index.has_filter()) {
+			ImGui::SameLine();
+			ImGui::TextDisabled("%zu matches", index.match_count());
+			if (!index.is_complete()) {
+				ImGui::SameLine();
+				ImGui::TextDisabled("(indexing...)");
+			}
+		}
+		return changed;
+	}
+
+	/* Render only the fields matching the index filter, plus their parents */
+	template<typename T>
+	ImResponse Input(const char* label, T& value, ImSettings& settings, search_index& index) {
+		if (!index.is_built_for(value, &settings)) {
+			index.build(value, settings);
+		}
+		index.update(index.get_nodes_per_frame());
+
+		const scope_search search(index);
+		ImResponse response;
+		Detail::InputImpl(label, value, settings, response);
+		if (response.get<std::remove_cv_t<T>>().is_changed()) index.elements_changed();
+		return response;
+	}
+
+	template<typename T>
+	ImResponse Input(const char* label, T& value, search_index& index) {
+		if (!index.is_built_for(value)) {
+			index.build(value);
+		}
+		index.update(index.get_nodes_per_frame());
+
+		const scope_search search(index);
+		ImSettings settings;
+		ImResponse response;
+		Detail::InputImpl(label, value, settings, response);
+		if (response.get<std::remove_cv_t<T>>().is_changed()) index.elements_changed();
+		return response;
+	}
+}
@@ -0,0 +1,370 @@
+#pragma once
+#include <imgui.h>
+
+#include "ImReflect_binary.hpp"
+#include "ImReflect_entry.hpp"
+#include "ImReflect_helper.hpp"
+
+/*
+* Live view of an object that lives in POSIX shared memory, for state that changes too often for a socket.
+*
+* The owning process keeps the object inside the segment and writes it in place, guarded by a seqlock:
+* writing never waits for readers. The inspector maps the object read-only, takes a consistent copy
+* once per frame and draws that with the usual widgets. Edits travel back through a lock-free
+* single-producer single-consumer queue in the segment, the owner applies them when it is ready.
+*
+* Only for types that are copied as a whole in binary snapshots: trivially copyable, no pointers.
+* Names follow ``shm_open``, e.g. "/physics". Some platforms need ``-lrt``.
+*
+* Example:
+*	// Simulation, 1 kHz
+*	ImReflect::shared_object<physics_state> shared;
+*	shared.create("/physics");
+*	while (running) {
+*		shared.apply_edits();
+*		auto state = shared.write(); // seqlock held while alive
+*		step(*state);
+*	}
+*
+*	// Inspector
+*	ImReflect::shared_view<physics_state> view;
+*	view.open("/physics");
+*	view.input("physics", settings); // every frame
+*/
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <type_traits>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace ImReflect {
+
+	namespace Detail {
+		inline constexpr std::uint32_t shared_magic = 0x53524D49; /* "IMRS" */
+		inline constexpr std::uint32_t shared_version = 1;
+		inline constexpr std::uint32_t shared_queue_capacity = 1024; /* power of two */
+
+		static_assert(std::atomic<std::uint32_t>::is_always_lock_free, "ImReflect Error: shared memory views need lock-free 32 bit atomics");
+
+		/* One queued edit: bytes of the object at ``offset``, larger leaves take several slots */
+		struct shared_edit {
+			std::uint32_t offset = 0;
+			std::uint32_t size = 0;
+			unsigned char bytes[56];
+		};
+
+		struct shared_header {
+			std::uint32_t magic = 0; /* set last, the segment is ready once it is valid */
+			std::uint32_t version = 0;
+			std::uint64_t schema = 0;
+			std::uint64_t object_size = 0;
+			std::uint64_t object_offset = 0; /* page aligned, so it can be mapped on its own */
+
+			alignas(64) std::atomic<std::uint32_t> sequence{ 0 };  /* odd while the owner writes */
+			alignas(64) std::atomic<std::uint32_t> edit_head{ 0 }; /* advanced by the inspector */
+			alignas(64) std::atomic<std::uint32_t> edit_tail{ 0 }; /* advanced by the owner */
+			shared_edit edits[shared_queue_capacity];
+		};
+
+		inline std::size_t shared_object_offset() {
+			const std::size_t page = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+			return (sizeof(shared_header) + page - 1) / page * page;
+		}
+
+		/* A mapping that is unmapped again when it goes away */
+		struct shared_mapping {
+			void* data = nullptr;
+			std::size_t size = 0;
+
+			bool map(int fd, std::size_t length, std::size_t offset, int protection) {
+				void* result = mmap(nullptr, length, protection, MAP_SHARED, fd, static_cast<off_t>(offset));
+				if (result == MAP_FAILED) return false;
+				data = result;
+				size = length;
+				return true;
+			}
+
+			void unmap() {
+				if (data) munmap(data, size);
+				data = nullptr;
+				size = 0;
+			}
+		};
+	}
+
+	/* Owner side: the object lives in the segment and is written in place */
+	template<typename T>
+	class shared_object {
+		static_assert(Detail::is_bulk_v<T>, "ImReflect Error: shared_object<T> needs a trivially copyable T without pointers");
+
+	public:
+		shared_object() = default;
+		~shared_object() { close(); }
+
+		shared_object(const shared_object&) = delete;
+		shared_object& operator=(const shared_object&) = delete;
+
+		/* Create (or replace) the segment ``name`` holding a copy of ``initial`` */
+		bool create(const char* name, const T& initial = T{}) {
+			close();
+			shm_unlink(name);
+			const int fd = shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0600);
+			if (fd < 0) return false;
+
+			const std::size_t offset = Detail::shared_object_offset();
+			const bool mapped = ftruncate(fd, static_cast<off_t>(offset + sizeof(T))) == 0 &&
+				_mapping.map(fd, offset + sizeof(T), 0, PROT_READ | PROT_WRITE);
+			::close(fd);
+			if (!mapped) {
+				shm_unlink(name);
+				return false;
+			}
+			_name = name;
+
+			_header = new (_mapping.data) Detail::shared_header();
+			_header->version = Detail::shared_version;
+			_header->schema = binary_schema_hash<T>();
+			_header->object_size = sizeof(T);
+			_header->object_offset = offset;
+			_object = new (static_cast<unsigned char*>(_mapping.data) + offset) T(initial);
+			std::atomic_thread_fence(std::memory_order_release);
+			reinterpret_cast<std::atomic<std::uint32_t>*>(&_header->magic)->store(Detail::shared_magic, std::memory_order_release);
+			return true;
+		}
+
+		/* Unmap and remove the segment, open views keep their mapping until they close */
+		void close() {
+			_mapping.unmap();
+			if (!_name.empty()) shm_unlink(_name.c_str());
+			_name.clear();
+			_header = nullptr;
+			_object = nullptr;
+		}
+
+		bool is_open() const { return _object != nullptr; }
+
+		/* Write access, readers retry while it is alive. Keep it short. */
+		class write_scope {
+		public:
+			explicit write_scope(shared_object& owner) : _owner(owner) { _owner.begin_write(); }
+			~write_scope() { _owner.end_write(); }
+			write_scope(const write_scope&) = delete;
+			write_scope& operator=(const write_scope&) = delete;
+
+			T& operator*() const { return *_owner._object; }
+			T* operator->() const { return _owner._object; }
+
+		private:
+			shared_object& _owner;
+		};
+
+		write_scope write() { return write_scope(*this); }
+
+		void begin_write() {
+			_header->sequence.fetch_add(1, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_release);
+		}
+
+		void end_write() {
+			_header->sequence.fetch_add(1, std::memory_order_release);
+		}
+
+		/* Copy ``value`` into the segment */
+		void publish(const T& value) {
+			const write_scope scope(*this);
+			std::memcpy(static_cast<void*>(_object), &value, sizeof(T));
+		}
+
+		/* The object in the segment, only write it between ``begin_write``/``end_write`` */
+		T* get() { return _object; }
+		const T* get() const { return _object; }
+
+		/* Apply the edits queued by inspectors, returns how many slots were applied */
+		std::size_t apply_edits() {
+			if (!is_open()) return 0;
+			std::uint32_t tail = _header->edit_tail.load(std::memory_order_relaxed);
+			const std::uint32_t head = _header->edit_head.load(std::memory_order_acquire);
+			if (tail == head) return 0;
+
+			const write_scope scope(*this);
+			unsigned char* const object = reinterpret_cast<unsigned char*>(_object);
+			std::size_t applied = 0;
+			for (; tail != head; ++tail, ++applied) {
+				const Detail::shared_edit& edit = _header->edits[tail % Detail::shared_queue_capacity];
+				if (edit.size <= sizeof(edit.bytes) && std::size_t(edit.offset) + edit.size <= sizeof(T)) {
+					std::memcpy(object + edit.offset, edit.bytes, edit.size);
+				}
+			}
+			_header->edit_tail.store(tail, std::memory_order_release);
+			return applied;
+		}
+
+	private:
+		Detail::shared_mapping _mapping;
+		Detail::shared_header* _header = nullptr;
+		T* _object = nullptr;
+		std::string _name;
+	};
+
+	/* Inspector side: maps the object read-only and sends edits back */
+	template<typename T>
+	class shared_view : private Detail::edit_journal {
+		static_assert(Detail::is_bulk_v<T>, "ImReflect Error: shared_view<T> needs a trivially copyable T without pointers");
+
+	public:
+		shared_view() = default;
+		~shared_view() { close(); }
+
+		shared_view(const shared_view&) = delete;
+		shared_view& operator=(const shared_view&) = delete;
+
+		bool open(const char* name) {
+			close();
+			const int fd = shm_open(name, O_RDWR, 0);
+			if (fd < 0) return false;
+
+			struct stat info {};
+			const std::size_t offset = Detail::shared_object_offset();
+			bool mapped = fstat(fd, &info) == 0 && static_cast<std::size_t>(info.st_size) >= offset + sizeof(T) &&
+				_control.map(fd, offset, 0, PROT_READ | PROT_WRITE) &&
+				_data.map(fd, sizeof(T), offset, PROT_READ);
+			::close(fd);
+
+			if (mapped) {
+				_header = static_cast<Detail::shared_header*>(_control.data);
+				const std::uint32_t magic = reinterpret_cast<std::atomic<std::uint32_t>*>(&_header->magic)->load(std::memory_order_acquire);
+				mapped = magic == Detail::shared_magic && _header->version == Detail::shared_version &&
+					_header->schema == binary_schema_hash<T>() && _header->object_size == sizeof(T) && _header->object_offset == offset;
+			}
+			if (!mapped) {
+				close();
+				return false;
+			}
+			_has_copy = false;
+			return true;
+		}
+
+		void close() {
+			_control.unmap();
+			_data.unmap();
+			_header = nullptr;
+			_has_copy = false;
+		}
+
+		bool is_open() const { return _header != nullptr; }
+
+		/* Consistent copy of the shared object, false when the owner kept writing for ``attempts`` tries */
+		bool read(T& out, int attempts = 64) const {
+			if (!is_open()) return false;
+			for (int i = 0; i < attempts; ++i) {
+				const std::uint32_t before = _header->sequence.load(std::memory_order_acquire);
+				if (before & 1u) continue;
+				std::memcpy(static_cast<void*>(&out), _data.data, sizeof(T));
+				std::atomic_thread_fence(std::memory_order_acquire);
+				if (_header->sequence.load(std::memory_order_relaxed) == before) return true;
+			}
+			return false;
+		}
+
+		/* Number of writes the owner finished, changes whenever the object may have changed */
+		std::uint32_t version() const { return is_open() ? _header->sequence.load(std::memory_order_acquire) / 2 : 0; }
+
+		/* Queue ``size`` bytes at ``offset`` of the object, false when the queue is full */
+		bool push_edit(std::size_t offset, const void* bytes, std::size_t size) {
+			if (!is_open() || offset + size > sizeof(T)) return false;
+			constexpr std::size_t chunk = sizeof(Detail::shared_edit::bytes);
+			const std::uint32_t slots = static_cast<std::uint32_t>((size + chunk - 1) / chunk);
+			const std::uint32_t head = _header->edit_head.load(std::memory_order_relaxed);
+			const std::uint32_t tail = _header->edit_tail.load(std::memory_order_acquire);
+			if (Detail::shared_queue_capacity - (head - tail) < slots) return false;
+
+			/* All slots of an edit are published at once, the owner never sees half of it */
+			const unsigned char* source = static_cast<const unsigned char*>(bytes);
+			for (std::uint32_t i = 0; i < slots; ++i) {
+				Detail::shared_edit& edit = _header->edits[(head + i) % Detail::shared_queue_capacity];
+				const std::size_t begin = i * chunk;
+				edit.offset = static_cast<std::uint32_t>(offset + begin);
+				edit.size = static_cast<std::uint32_t>(std::min(chunk, size - begin));
+				std::memcpy(edit.bytes, source + begin, edit.size);
+			}
+			_header->edit_head.store(head + slots, std::memory_order_release);
+			return true;
+		}
+
+		/* Latest copy, refreshed by ``input`` */
+		const T* get() const { return _has_copy ? &_copy : nullptr; }
+
+		/* Draw the shared object, edits are queued for the owner */
+		ImResponse input(const char* label, ImSettings& settings) {
+			/* Keep the local value while it is being dragged or typed, the owner hasn't applied it yet */
+			if (is_open() && (!_has_copy || !ImGui::IsAnyItemActive())) {
+				_has_copy |= read(_copy);
+			}
+			if (!_has_copy) {
+				Detail::text_label(label);
+				ImGui::TextDisabled(is_open() ? "Waiting for a consistent copy..." : "Not connected");
+				return {};
+			}
+
+			Detail::edit_journal*& active = Detail::active_journal();
+			_next = active;
+			active = this;
+			ImResponse response;
+			Detail::InputImpl(label, _copy, settings, response);
+			active = _next;
+			_next = nullptr;
+			return response;
+		}
+
+		ImResponse input(const char* label) {
+			ImSettings settings;
+			return input(label, settings);
+		}
+
+	private:
+		void on_leaf(const char* label, void* address, const Detail::journal_codec& codec, const void* before, bool changed, bool active, bool finished) override {
+			if (_next) _next->on_leaf(label, address, codec, before, changed, active, finished);
+			if (!changed) return;
+
+			const unsigned char* const begin = reinterpret_cast<const unsigned char*>(&_copy);
+			const unsigned char* const leaf = static_cast<const unsigned char*>(address);
+			if (std::less<const unsigned char*>()(leaf, begin) || !std::less<const unsigned char*>()(leaf, begin + sizeof(T))) return;
+
+			/* Leaves of bulk types are trivially copyable, the bytes are the value */
+			const std::size_t size = codec.size(address);
+			push_edit(static_cast<std::size_t>(leaf - begin), address, size);
+		}
+
+		void on_replace(const char* label, void* address, const void* type, const Detail::journal_codec* codec, const unsigned char* before, std::size_t before_size) override {
+			if (_next) _next->on_replace(label, address, type, codec, before, before_size);
+			if (codec == nullptr) return;
+
+			const unsigned char* const begin = reinterpret_cast<const unsigned char*>(&_copy);
+			const unsigned char* const value = static_cast<const unsigned char*>(address);
+			if (std::less<const unsigned char*>()(value, begin) || !std::less<const unsigned char*>()(value, begin + sizeof(T))) return;
+
+			/* Everything inside is bulk, the snapshot of a value is its bytes */
+			push_edit(static_cast<std::size_t>(value - begin), address, codec->size(address));
+		}
+
+		bool take_applied(const void* address, const void* type) override {
+			return _next != nullptr && _next->take_applied(address, type);
+		}
+
+		Detail::shared_mapping _control; /* header and edit queue, read-write */
+		Detail::shared_mapping _data;    /* the object, read-only */
+		Detail::shared_header* _header = nullptr;
+		Detail::edit_journal* _next = nullptr;
+		T _copy{};
+		bool _has_copy = false;
+	};
+}
+
+#endif
@@ -2,7 +2,10 @@
 #include <imgui.h>
 #include <imgui_stdlib.h>
 
+#include "ImReflect_clipboard.hpp"
 #include "ImReflect_helper.hpp"
+#include "ImReflect_record.hpp"
+#include "ImReflect_traits.hpp"
 
 #include <extern/magic_enum/magic_enum.hpp>
 #include <extern/svh/scope.hpp>
@@ -10,6 +13,7 @@
 #include <type_traits>
 #include <algorithm>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <list>
 #include <array>
@@ -19,30 +23,78 @@
 #include <unordered_set>
 #include <forward_list>
 #include <variant>
+#include <atomic>
+#include <cfloat>
+#include <cmath>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+#if __cplusplus >= 202002L || (defined(_MSVC_LANG) && _MSVC_LANG >= 202002L)
+#include <span>
+#endif
 
 /* Helpers */
 namespace ImReflect::Detail {
-	template<typename T> /* All numbers except bool */
-	constexpr bool is_string_type_v = std::is_same_v<std::remove_cv_t<T>, std::string>;
+	template<typename T> /* std::string with any allocator, std::pmr::string included */
+	constexpr bool is_string_type_v = is_char_string_v<T>;
 
 	template<typename T>
 	using enable_if_string_t = std::enable_if_t<is_string_type_v<T>, void>;
 
-	/* Is Smart pointers */
-	template<typename T>
-	struct is_smart_pointer_impl : std::false_type {};
-	template<typename T>
-	struct is_smart_pointer_impl<std::shared_ptr<T>> : std::true_type {};
-	template<typename T>
-	struct is_smart_pointer_impl<std::unique_ptr<T>> : std::true_type {};
-	template<typename T>
-	struct is_smart_pointer_impl<std::weak_ptr<T>> : std::true_type {};
+	/* ``imgui_stdlib`` only takes std::string, other allocators grow the string through this callback */
+	template<typename String>
+	int string_resize_callback(ImGuiInputTextCallbackData* data) {
+		if (data->EventFlag == ImGuiInputTextFlags_CallbackResize) {
+			String* str = static_cast<String*>(data->UserData);
+			str->resize(static_cast<std::size_t>(data->BufTextLen));
+			data->Buf = str->data();
+		}
+		return 0;
+	}
+
+	template<typename String>
+	bool input_text(const char* label, String& value, ImGuiInputTextFlags flags) {
+		if constexpr (std::is_same_v<String, std::string>) {
+			return ImGui::InputText(label, &value, flags);
+		} else {
+			flags |= ImGuiInputTextFlags_CallbackResize;
+			return ImGui::InputText(label, value.data(), value.capacity() + 1, flags, string_resize_callback<String>, &value);
+		}
+	}
 
+	template<typename String>
+	bool input_text_multiline(const char* label, String& value, const ImVec2& size, ImGuiInputTextFlags flags) {
+		if constexpr (std::is_same_v<String, std::string>) {
+			return ImGui::InputTextMultiline(label, &value, size, flags);
+		} else {
+			flags |= ImGuiInputTextFlags_CallbackResize;
+			return ImGui::InputTextMultiline(label, value.data(), value.capacity() + 1, size, flags, string_resize_callback<String>, &value);
+		}
+	}
+}
+
+namespace ImReflect {
 	template<typename T>
-	constexpr bool is_smart_pointer_v = Detail::is_smart_pointer_impl<std::remove_cv_t<T>>::value;
+	class array_view;
+}
 
+namespace ImReflect::Detail {
 	template<typename T>
-	using enable_if_smart_pointer_t = std::enable_if_t<is_smart_pointer_v<T>, void>;
+	struct is_array_view_impl : std::false_type {};
+	template<typename T>
+	struct is_array_view_impl<array_view<T>> : std::true_type {};
+
+	/* Elements stored back to back, data() can be handed to the kernels */
+	template<typename Container>
+	constexpr bool is_contiguous_storage_v = is_std_array_v<Container> || is_array_view_impl<std::remove_cv_t<Container>>::value ||
+		(is_std_vector_v<Container> && !std::is_same_v<typename Container::value_type, bool>);
 }
 
 /* Generic settings for types */
@@ -141,6 +193,72 @@ namespace ImReflect::Detail {
 		const bool& is_removable() const { return _removable; };
 	};
 
+	template<typename T>
+	struct summary_mixin {
+	private:
+		bool _summary = false;
+		int _histogram_bins = 32;
+		std::size_t _summary_async_threshold = std::size_t(1) << 18;
+		std::uint64_t _summary_version = 0;
+	public:
+		/* Min, max, mean, standard deviation and a histogram above the items, numeric element types only */
+		type_settings<T>& summary(const bool v = true) { _summary = v; RETURN_THIS; }
+		type_settings<T>& histogram_bins(const int v) { _histogram_bins = v; RETURN_THIS; }
+		/* Containers with at least this many elements are summarized on a worker thread */
+		type_settings<T>& summary_async_threshold(const std::size_t v) { _summary_async_threshold = v; RETURN_THIS; }
+		/*
+		* The summary is computed again when the size, a sampled element (see summary_checksum) or this
+		* changes. Bump it after writing elements outside of the widget, edits made here are always seen.
+		*/
+		type_settings<T>& summary_version(const std::uint64_t v) { _summary_version = v; RETURN_THIS; }
+		const bool& has_summary() const { return _summary; }
+		const int& get_histogram_bins() const { return _histogram_bins; }
+		const std::size_t& get_summary_async_threshold() const { return _summary_async_threshold; }
+		const std::uint64_t& get_summary_version() const { return _summary_version; }
+	};
+
+	template<typename T>
+	struct plot_mixin {
+	private:
+		enum class plot_mode { none, lines, histogram };
+		plot_mode _plot = plot_mode::none;
+		float _plot_height = 0.0f;
+		std::uint64_t _plot_version = 0;
+	public:
+		/* Draw numeric elements as a read-only plot instead of one widget per item */
+		type_settings<T>& as_plot(const bool v = true) { _plot = v ? plot_mode::lines : plot_mode::none; RETURN_THIS; }
+		type_settings<T>& as_plot_histogram(const bool v = true) { _plot = v ? plot_mode::histogram : plot_mode::none; RETURN_THIS; }
+		/* 0 = four frame heights */
+		type_settings<T>& plot_height(const float v) { _plot_height = v; RETURN_THIS; }
+		/*
+		* The decimated plot is kept until the size, the width, a sampled checksum or the edit count of
+		* the container (edits through any widget) changes. Writes made outside of the widgets between
+		* the samples are only seen when this changes: pass a counter your code bumps with the data.
+		*/
+		type_settings<T>& plot_version(const std::uint64_t v) { _plot_version = v; RETURN_THIS; }
+		bool is_plot() const { return _plot == plot_mode::lines; }
+		bool is_plot_histogram() const { return _plot == plot_mode::histogram; }
+		const float& get_plot_height() const { return _plot_height; }
+		const std::uint64_t& get_plot_version() const { return _plot_version; }
+	};
+
+	template<typename T>
+	struct memory_view_mixin {
+	private:
+		bool _memory_view = false;
+		int _bytes_per_row = 16;
+		int _memory_view_rows = 16;
+	public:
+		/* Hex and ASCII columns instead of one widget per element, single byte elements only */
+		type_settings<T>& as_memory_view(const bool v = true) { _memory_view = v; RETURN_THIS; }
+		type_settings<T>& bytes_per_row(const int v) { _bytes_per_row = v; RETURN_THIS; }
+		/* Visible rows, the rest scrolls */
+		type_settings<T>& memory_view_rows(const int v) { _memory_view_rows = v; RETURN_THIS; }
+		const bool& is_memory_view() const { return _memory_view; }
+		const int& get_bytes_per_row() const { return _bytes_per_row; }
+		const int& get_memory_view_rows() const { return _memory_view_rows; }
+	};
+
 	template<typename T>
 	struct resettable_mixin {
 	private:
@@ -156,8 +274,8 @@ namespace ImReflect {
 	/* ========================= std::string ========================= */
 	template<typename T>
 	struct type_settings<T, Detail::enable_if_string_t<T>> : ImRequired<T>,
-		ImReflect::Detail::input_flags<std::string>,
-		ImReflect::Detail::text_input<std::string> {
+		ImReflect::Detail::input_flags<std::remove_cv_t<T>>,
+		ImReflect::Detail::text_input<std::remove_cv_t<T>> {
 	};
 
 	template<typename T>
@@ -188,9 +306,9 @@ namespace ImReflect {
 					size = ImVec2(0, Detail::multiline_text_height(line_height));
 				}
 
-				changed = ImGui::InputTextMultiline(label, &value, size, flags);
+				changed = Detail::input_text_multiline(label, value, size, flags);
 			} else {
-				changed = ImGui::InputText(label, &value, flags);
+				changed = Detail::input_text(label, value, flags);
 			}
 		} else {
 			/* Const value, just display */
@@ -211,6 +329,132 @@ namespace ImReflect {
 		ImReflect::Detail::check_input_states(string_response);
 	}
 
+	/* ========================= char[N], std::array<char, N> ========================= */
+	/* Fixed capacity text, ``InputText`` writes straight into the buffer so nothing is allocated */
+	struct char_buffer {};
+
+	template<>
+	struct type_settings<char_buffer> : ImRequired<char_buffer>,
+		ImReflect::Detail::input_flags<char_buffer>,
+		ImReflect::Detail::text_input<char_buffer> {
+	};
+
+	namespace Detail {
+		/* ``Char`` is const char for read only buffers */
+		template<typename Char>
+		void char_buffer_input(const char* label, Char* buffer, std::size_t capacity, ImSettings& settings, ImResponse& response) {
+			auto& text_settings = settings.get<char_buffer>();
+			auto& text_response = response.get<char_buffer>();
+
+			constexpr bool is_const = std::is_const_v<Char>;
+			const char* terminator = static_cast<const char*>(std::memchr(buffer, '\0', capacity));
+			const std::size_t length = terminator ? static_cast<std::size_t>(terminator - buffer) : capacity;
+
+			bool changed = false;
+			if constexpr (is_const == false) {
+				if (terminator) {
+					const auto& flags = text_settings.get_input_flags();
+					if (text_settings.is_multiline()) {
+						const int line_height = text_settings.get_line_count();
+						ImVec2 size;
+						if (line_height < 0) {
+							/* imgui default */
+							size = ImVec2(0, 0);
+						} else if (line_height == 0) {
+							/* auto resize, calculate height based on number of lines in the buffer */
+							const std::size_t lines = std::count(buffer, buffer + length, '\n') + 1;
+							size = ImVec2(0, Detail::multiline_text_height(lines));
+						} else {
+							size = ImVec2(0, Detail::multiline_text_height(line_height));
+						}
+
+						changed = ImGui::InputTextMultiline(label, buffer, capacity, size, flags);
+					} else {
+						changed = ImGui::InputText(label, buffer, capacity, flags);
+					}
+				}
+			}
+			if (is_const || !terminator) {
+				/* Const or not null terminated, ``InputText`` would read past the end, just display */
+				ImReflect::Detail::text_label(label);
+				ImReflect::Detail::imgui_tooltip(is_const ? "Value is const" : "Buffer is not null terminated");
+
+				ImGui::BeginDisabled();
+				ImGui::SameLine();
+
+				ImGui::TextWrapped("%.*s", static_cast<int>(length), buffer);
+
+				ImGui::EndDisabled();
+			}
+
+			if (changed) {
+				text_response.changed();
+			}
+			ImReflect::Detail::check_input_states(text_response);
+		}
+	}
+
+	template<std::size_t N>
+	void tag_invoke(Detail::ImInputLib_t, const char* label, char(&value)[N], ImSettings& settings, ImResponse& response) {
+		Detail::char_buffer_input(label, value, N, settings, response);
+	}
+
+	template<std::size_t N>
+	void tag_invoke(Detail::ImInputLib_t, const char* label, const char(&value)[N], ImSettings& settings, ImResponse& response) {
+		Detail::char_buffer_input(label, value, N, settings, response);
+	}
+
+	template<std::size_t N>
+	void tag_invoke(Detail::ImInputLib_t, const char* label, std::array<char, N>& value, ImSettings& settings, ImResponse& response) {
+		Detail::char_buffer_input(label, value.data(), N, settings, response);
+	}
+
+	template<std::size_t N>
+	void tag_invoke(Detail::ImInputLib_t, const char* label, const std::array<char, N>& value, ImSettings& settings, ImResponse& response) {
+		Detail::char_buffer_input(label, value.data(), N, settings, response);
+	}
+
+	/* ========================= std::string_view ========================= */
+	/* Never owns its characters, so it is only displayed */
+	inline void tag_invoke(Detail::ImInputLib_t, const char* label, const std::string_view& value, ImSettings& /*settings*/, ImResponse& response) {
+		auto& view_response = response.get<std::string_view>();
+
+		ImReflect::Detail::text_label(label);
+		ImReflect::Detail::imgui_tooltip("std::string_view is read only");
+
+		ImGui::BeginDisabled();
+		ImGui::SameLine();
+
+		ImGui::TextWrapped("%.*s", static_cast<int>(value.size()), value.data());
+
+		ImGui::EndDisabled();
+
+		ImReflect::Detail::check_input_states(view_response);
+	}
+
+	/* ========================= std::byte ========================= */
+	/* An enum without enumerators, edited as a hex number instead of going through magic_enum */
+	inline void tag_invoke(Detail::ImInputLib_t, const char* label, std::byte& value, ImSettings& /*settings*/, ImResponse& response) {
+		auto& byte_response = response.get<std::byte>();
+
+		unsigned char raw = std::to_integer<unsigned char>(value);
+		if (ImGui::InputScalar(label, ImGuiDataType_U8, &raw, nullptr, nullptr, "%02X", ImGuiInputTextFlags_CharsHexadecimal)) {
+			value = std::byte{ raw };
+			byte_response.changed();
+		}
+		ImReflect::Detail::check_input_states(byte_response);
+	}
+
+	inline void tag_invoke(Detail::ImInputLib_t, const char* label, const std::byte& value, ImSettings& /*settings*/, ImResponse& response) {
+		auto& byte_response = response.get<const std::byte>();
+
+		ImReflect::Detail::text_label(label);
+		ImReflect::Detail::imgui_tooltip("Value is const");
+		ImGui::SameLine();
+		ImGui::TextDisabled("%02X", std::to_integer<unsigned>(value));
+		ImReflect::Detail::check_input_states(byte_response);
+	}
+
 	/* ========================= Smart pointers ========================= */
 	template<typename T>
 	struct type_settings<T, Detail::enable_if_smart_pointer_t<T>> : ImRequired<T> {
@@ -450,6 +694,8 @@ namespace ImReflect {
 
 			size_t _inserted_index = INVALID_INDEX;
 			size_t _erased_index = INVALID_INDEX;
+			size_t _changed_first = INVALID_INDEX;
+			size_t _changed_last = INVALID_INDEX;
 
 			struct move_info {
 				size_t from = INVALID_INDEX;
@@ -462,10 +708,13 @@ namespace ImReflect {
 			bool has_inserted() const { return _inserted_index != INVALID_INDEX; }
 			bool has_erased() const { return _erased_index != INVALID_INDEX; }
 			bool has_moved() const { return _moved_info.from != INVALID_INDEX && _moved_info.to != INVALID_INDEX; }
+			/* Set by bulk operations: one changed() for the elements in [first, last) */
+			bool has_changed_range() const { return _changed_first != INVALID_INDEX; }
 
 			size_t get_inserted_index() const { return _inserted_index; }
 			size_t get_erased_index() const { return _erased_index; }
 			move_info get_moved_info() const { return _moved_info; }
+			std::pair<size_t, size_t> get_changed_range() const { return { _changed_first, _changed_last }; }
 
 			void inserted_index(const size_t index) { _inserted_index = index; }
 			void erased_index(const size_t index) { _erased_index = index; }
@@ -473,6 +722,10 @@ namespace ImReflect {
 				_moved_info.from = from;
 				_moved_info.to = to;
 			}
+			void changed_range(const size_t first, const size_t last) {
+				_changed_first = first;
+				_changed_last = last;
+			}
 		};
 
 		constexpr const char* VECTOR_TREE_LABEL = "##vector_tree";
@@ -551,21 +804,8 @@ namespace ImReflect {
 			static std::false_type test_key_type(...);
 			static constexpr bool is_associative = decltype(test_key_type<Container>(0))::value;
 
-			/* Check if container allows duplicates */
-			template<typename C>
-			static auto test_multiset(int) -> decltype(
-				std::declval<C>().insert(std::declval<value_type>()),
-				typename C::key_compare{},
-				std::is_same<C, std::multiset<typename C::value_type>>{} ||
-				std::is_same<C, std::multimap<typename C::key_type, typename C::mapped_type>>{},
-				std::true_type{}
-				);
-
-			template<typename>
-			static std::false_type test_multiset(...);
-			static constexpr bool allows_duplicates = is_associative &&
-				(std::is_same_v<Container, std::multiset<value_type>> ||
-					std::is_same_v<Container, std::unordered_multiset<value_type>>);
+			/* Check if container allows duplicates, any comparator, hash or allocator */
+			static constexpr bool allows_duplicates = is_associative && allows_duplicate_keys_v<Container>;
 
 			/* Check if container has size */
 			template<typename C>
@@ -587,6 +827,680 @@ namespace ImReflect {
 			}
 		}
 
+		/* ========================= Container summary ========================= */
+
+		struct container_summary {
+			std::size_t count = 0;      /* finite values */
+			std::size_t non_finite = 0; /* NaN and infinities, not part of anything else */
+			double min = 0.0;
+			double max = 0.0;
+			double mean = 0.0;
+			double stddev = 0.0;
+			std::vector<float> histogram;
+		};
+
+		/*
+		* The kernels work on contiguous data in four independent lanes, a shape compilers turn into
+		* vector instructions without intrinsics. ``n`` > 0.
+		*/
+		template<typename T>
+		void summary_moments(const T* data, std::size_t n, T& min, T& max, double& sum) {
+			T lo[4] = { data[0], data[0], data[0], data[0] };
+			T hi[4] = { data[0], data[0], data[0], data[0] };
+			double acc[4] = { 0.0, 0.0, 0.0, 0.0 };
+			std::size_t i = 0;
+			for (; i + 4 <= n; i += 4) {
+				for (std::size_t lane = 0; lane < 4; ++lane) {
+					const T x = data[i + lane];
+					lo[lane] = x < lo[lane] ? x : lo[lane];
+					hi[lane] = hi[lane] < x ? x : hi[lane];
+					acc[lane] += static_cast<double>(x);
+				}
+			}
+			for (; i < n; ++i) {
+				lo[0] = data[i] < lo[0] ? data[i] : lo[0];
+				hi[0] = hi[0] < data[i] ? data[i] : hi[0];
+				acc[0] += static_cast<double>(data[i]);
+			}
+			min = std::min(std::min(lo[0], lo[1]), std::min(lo[2], lo[3]));
+			max = std::max(std::max(hi[0], hi[1]), std::max(hi[2], hi[3]));
+			sum = (acc[0] + acc[1]) + (acc[2] + acc[3]);
+		}
+
+		/* Squared distance to the mean, second pass so large offsets don't cancel out */
+		template<typename T>
+		double summary_squares(const T* data, std::size_t n, double mean) {
+			double acc[4] = { 0.0, 0.0, 0.0, 0.0 };
+			std::size_t i = 0;
+			for (; i + 4 <= n; i += 4) {
+				for (std::size_t lane = 0; lane < 4; ++lane) {
+					const double d = static_cast<double>(data[i + lane]) - mean;
+					acc[lane] += d * d;
+				}
+			}
+			for (; i < n; ++i) {
+				const double d = static_cast<double>(data[i]) - mean;
+				acc[0] += d * d;
+			}
+			return (acc[0] + acc[1]) + (acc[2] + acc[3]);
+		}
+
+		template<typename T>
+		void summary_histogram(const T* data, std::size_t n, double min, double max, std::vector<float>& bins) {
+			const std::size_t count = bins.size();
+			const double scale = max > min ? static_cast<double>(count) / (max - min) : 0.0;
+			for (std::size_t i = 0; i < n; ++i) {
+				const std::size_t bin = static_cast<std::size_t>((static_cast<double>(data[i]) - min) * scale);
+				bins[bin < count ? bin : count - 1] += 1.0f;
+			}
+		}
+
+		template<typename T>
+		container_summary summarize(const T* data, std::size_t n, int bins) {
+			container_summary result;
+			if (n == 0) return result;
+
+			T min, max;
+			double sum;
+			summary_moments(data, n, min, max, sum);
+
+			/* Only floating point sums go non-finite, leave NaN and infinities out and run again */
+			std::vector<T> finite;
+			if constexpr (std::is_floating_point_v<T>) {
+				if (!std::isfinite(sum)) {
+					finite.reserve(n);
+					for (std::size_t i = 0; i < n; ++i) {
+						if (std::isfinite(data[i])) finite.push_back(data[i]);
+					}
+					result.non_finite = n - finite.size();
+					data = finite.data();
+					n = finite.size();
+					if (n == 0) return result;
+					summary_moments(data, n, min, max, sum);
+				}
+			}
+
+			result.count = n;
+			result.min = static_cast<double>(min);
+			result.max = static_cast<double>(max);
+			result.mean = sum / static_cast<double>(n);
+			result.stddev = std::sqrt(summary_squares(data, n, result.mean) / static_cast<double>(n));
+			result.histogram.assign(static_cast<std::size_t>(std::max(bins, 1)), 0.0f);
+			summary_histogram(data, n, result.min, result.max, result.histogram);
+			return result;
+		}
+
+		/*
+		* Size and up to 64 sampled elements: spread evenly with random access, otherwise from both ends
+		* (only the front for forward lists), walking to the middle of a list would visit every node.
+		* Writes between the samples made outside of the widget need ``summary_version``/``plot_version``.
+		*/
+		template<typename Container>
+		std::uint64_t summary_checksum(const Container& value, std::size_t size) {
+			using T = typename Container::value_type;
+			std::uint64_t hash = 14695981039346656037ull ^ size;
+			const auto mix = [&hash](const T& element) {
+				unsigned char bytes[sizeof(T)];
+				std::memcpy(bytes, &element, sizeof(T));
+				for (unsigned char byte : bytes) hash = (hash ^ byte) * 1099511628211ull;
+				};
+			using category = typename std::iterator_traits<typename Container::const_iterator>::iterator_category;
+			constexpr std::size_t samples = 64;
+			if (size <= samples) {
+				for (const T& element : value) mix(element);
+			} else if constexpr (std::is_base_of_v<std::random_access_iterator_tag, category>) {
+				for (std::size_t i = 0; i < samples; ++i) mix(value[i * (size - 1) / (samples - 1)]);
+			} else {
+				constexpr std::size_t ends = samples / 2;
+				auto front = value.begin();
+				for (std::size_t i = 0; i < ends; ++i, ++front) mix(*front);
+				if constexpr (std::is_base_of_v<std::bidirectional_iterator_tag, category>) {
+					auto back = value.end();
+					for (std::size_t i = 0; i < ends; ++i) mix(*--back);
+				}
+			}
+			return hash;
+		}
+
+		struct summary_job : async_call {
+			container_summary result;
+		};
+
+		/* Kept in the widget store, the result stays until the size, the checksum or the version changes */
+		struct summary_state {
+			bool valid = false;
+			std::size_t size = 0;
+			std::uint64_t checksum = 0;
+			std::uint64_t version = 0;
+			bool has_result = false;
+			container_summary result;
+			std::shared_ptr<summary_job> job; /* running on the pool, for ``size`` and ``checksum`` */
+		};
+
+		template<typename Container, typename Settings>
+		void draw_container_summary(const Container& value, std::size_t size, const Settings& settings, summary_state& state) {
+			using T = typename Container::value_type;
+
+			if (state.job && state.job->done.load(std::memory_order_acquire)) {
+				state.result = std::move(state.job->result);
+				state.has_result = true;
+				state.job.reset();
+			}
+
+			/* Nothing is copied or summarized while the container looks the same */
+			const std::uint64_t checksum = summary_checksum(value, size);
+			const std::uint64_t version = settings.get_summary_version();
+			if (!state.job && (!state.valid || size != state.size || checksum != state.checksum || version != state.version)) {
+				state.valid = true;
+				state.size = size;
+				state.checksum = checksum;
+				state.version = version;
+				const int bins = settings.get_histogram_bins();
+				if (size >= settings.get_summary_async_threshold()) {
+					/* The worker gets its own copy, the container may change under it */
+					auto data = std::make_shared<std::vector<T>>(value.begin(), value.end());
+					auto job = std::make_shared<summary_job>();
+					async_pool::instance().submit([job, data, bins]() {
+						job->result = summarize(data->data(), data->size(), bins);
+						job->done.store(true, std::memory_order_release);
+						});
+					state.job = std::move(job);
+				} else if constexpr (is_contiguous_storage_v<Container>) {
+					state.result = summarize(value.data(), size, bins);
+					state.has_result = true;
+				} else {
+					const std::vector<T> data(value.begin(), value.end());
+					state.result = summarize(data.data(), data.size(), bins);
+					state.has_result = true;
+				}
+			}
+
+			if (state.has_result) {
+				const container_summary& result = state.result;
+				if (result.count == 0) {
+					ImGui::TextDisabled("no finite values");
+				} else {
+					ImGui::TextDisabled("min %.6g  max %.6g  mean %.6g  stddev %.6g", result.min, result.max, result.mean, result.stddev);
+				}
+				if (result.non_finite > 0) {
+					ImGui::SameLine();
+					ImGui::TextDisabled("(%zu non-finite)", result.non_finite);
+				}
+			}
+			if (state.job) {
+				if (state.has_result) ImGui::SameLine();
+				ImGui::TextDisabled("summarizing %c", "|/-\\"[static_cast<int>(ImGui::GetTime() * 8.0) & 3]);
+			}
+			if (state.has_result && !state.result.histogram.empty() && state.result.count > 0) {
+				const auto& histogram = state.result.histogram;
+				ImGui::PlotHistogram("##summary_histogram", histogram.data(), static_cast<int>(histogram.size()),
+					0, nullptr, 0.0f, FLT_MAX, ImVec2(0.0f, ImGui::GetFrameHeight() * 2.0f));
+				if (ImGui::IsItemHovered()) {
+					ImGui::SetTooltip("%zu values in %zu bins from %.6g to %.6g", state.result.count, histogram.size(), state.result.min, state.result.max);
+				}
+			}
+		}
+
+		/* ========================= Container plot ========================= */
+
+		template<typename T>
+		void minmax_kernel(const T* data, std::size_t n, T& min, T& max) {
+			T lo[4] = { data[0], data[0], data[0], data[0] };
+			T hi[4] = { data[0], data[0], data[0], data[0] };
+			std::size_t i = 0;
+			for (; i + 4 <= n; i += 4) {
+				for (std::size_t lane = 0; lane < 4; ++lane) {
+					const T x = data[i + lane];
+					lo[lane] = x < lo[lane] ? x : lo[lane];
+					hi[lane] = hi[lane] < x ? x : hi[lane];
+				}
+			}
+			for (; i < n; ++i) {
+				lo[0] = data[i] < lo[0] ? data[i] : lo[0];
+				hi[0] = hi[0] < data[i] ? data[i] : hi[0];
+			}
+			min = std::min(std::min(lo[0], lo[1]), std::min(lo[2], lo[3]));
+			max = std::max(std::max(hi[0], hi[1]), std::max(hi[2], hi[3]));
+		}
+
+		/*
+		* Min/max per bucket, one bucket per pixel. Lines get both extremes so spikes survive,
+		* histograms get the maximum. Short sequences are copied as they are.
+		*/
+		template<typename T>
+		void decimate(const T* data, std::size_t n, std::size_t buckets, bool histogram, std::vector<float>& points) {
+			points.clear();
+			if (n <= buckets * (histogram ? 1 : 2)) {
+				points.assign(data, data + n);
+				return;
+			}
+			points.reserve(buckets * (histogram ? 1 : 2));
+			for (std::size_t b = 0; b < buckets; ++b) {
+				const std::size_t begin = b * n / buckets;
+				const std::size_t end = (b + 1) * n / buckets;
+				T min, max;
+				minmax_kernel(data + begin, end - begin, min, max);
+				if (!histogram) points.push_back(static_cast<float>(min));
+				points.push_back(static_cast<float>(max));
+			}
+		}
+
+		/*
+		* Edits made to a container through any widget this or last frame, keyed by its address.
+		* A plot drawn in one window sees edits made to the same container in another.
+		*/
+		struct container_edits {
+			std::uint64_t count = 0;
+		};
+
+		inline container_edits& container_edits_of(const void* container) {
+			const std::uint64_t key = static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(container)) * 0x9E3779B97F4A7C15ull;
+			return widget_store::current().get<container_edits>(static_cast<ImGuiID>(key ^ (key >> 32)));
+		}
+
+		/* Kept in the widget store, decimated again when the input, its edit count or the width changes */
+		struct plot_state {
+			bool valid = false;
+			std::size_t size = 0;
+			std::uint64_t checksum = 0;
+			std::uint64_t edits = 0;
+			std::uint64_t version = 0;
+			std::size_t buckets = 0;
+			bool histogram = false;
+			std::vector<float> points;
+		};
+
+		template<typename Container, typename Settings>
+		void draw_container_plot(const Container& value, const Settings& settings, plot_state& state) {
+			const std::size_t size = value.size();
+			const float width = ImGui::CalcItemWidth();
+			const float height = settings.get_plot_height() > 0.0f ? settings.get_plot_height() : ImGui::GetFrameHeight() * 4.0f;
+			const std::size_t buckets = static_cast<std::size_t>(std::max(width, 1.0f));
+			const bool histogram = settings.is_plot_histogram();
+
+			const std::uint64_t checksum = summary_checksum(value, size);
+			const std::uint64_t edits = container_edits_of(&value).count;
+			if (!state.valid || state.size != size || state.checksum != checksum || state.edits != edits || state.version != settings.get_plot_version() ||
+				state.buckets != buckets || state.histogram != histogram) {
+				state.valid = true;
+				state.size = size;
+				state.checksum = checksum;
+				state.edits = edits;
+				state.version = settings.get_plot_version();
+				state.buckets = buckets;
+				state.histogram = histogram;
+				if (size > 0) decimate(value.data(), size, buckets, histogram, state.points);
+				else state.points.clear();
+			}
+
+			char overlay[64] = "";
+			if (state.points.size() < size) std::snprintf(overlay, sizeof(overlay), "%zu samples", size);
+			const int count = static_cast<int>(state.points.size());
+			if (histogram) {
+				ImGui::PlotHistogram("##plot", state.points.data(), count, 0, overlay, FLT_MAX, FLT_MAX, ImVec2(width, height));
+			} else {
+				ImGui::PlotLines("##plot", state.points.data(), count, 0, overlay, FLT_MAX, FLT_MAX, ImVec2(width, height));
+			}
+
+			/* The built-in tooltip shows decimated indices, show the sample under the mouse instead */
+			if (size > 0 && ImGui::IsItemHovered()) {
+				const ImVec2 min = ImGui::GetItemRectMin();
+				const ImVec2 extent = ImGui::GetItemRectSize();
+				const float t = extent.x > 0.0f ? (ImGui::GetMousePos().x - min.x) / extent.x : 0.0f;
+				const std::size_t index = std::min(static_cast<std::size_t>(std::max(t, 0.0f) * static_cast<float>(size)), size - 1);
+				ImGui::SetTooltip("[%zu] %.6g", index, static_cast<double>(value[index]));
+			}
+		}
+
+		/* ========================= Bulk operations ========================= */
+
+		/*
+		* Kernels over an iterator range. Vectors and arrays pass raw pointers, which compilers
+		* vectorize, lists and deques pass their own iterators.
+		*/
+		template<typename It, typename T>
+		void bulk_fill(It first, It last, const T value) {
+			for (; first != last; ++first) *first = value;
+		}
+
+		/* x * scale + offset, integers are rounded and saturated */
+		template<typename It>
+		void bulk_affine(It first, It last, const double scale, const double offset) {
+			using T = std::remove_reference_t<decltype(*first)>;
+			if constexpr (std::is_floating_point_v<T>) {
+				const T s = static_cast<T>(scale);
+				const T o = static_cast<T>(offset);
+				for (; first != last; ++first) *first = *first * s + o;
+			} else {
+				constexpr double lo = static_cast<double>(std::numeric_limits<T>::lowest());
+				constexpr double hi = static_cast<double>(std::numeric_limits<T>::max());
+				for (; first != last; ++first) {
+					const double x = std::round(static_cast<double>(*first) * scale + offset);
+					*first = x <= lo ? std::numeric_limits<T>::lowest() : x >= hi ? std::numeric_limits<T>::max() : static_cast<T>(x);
+				}
+			}
+		}
+
+		template<typename It, typename T>
+		void bulk_clamp(It first, It last, const T lo, const T hi) {
+			for (; first != last; ++first) {
+				const T x = *first;
+				*first = x < lo ? lo : hi < x ? hi : x;
+			}
+		}
+
+		/* Rescale to [0, 1], all zero when every element is the same */
+		template<typename It>
+		void bulk_normalize(It first, It last) {
+			using T = std::remove_reference_t<decltype(*first)>;
+			if (first == last) return;
+			T min, max;
+			if constexpr (std::is_pointer_v<It>) {
+				minmax_kernel(first, static_cast<std::size_t>(last - first), min, max);
+			} else {
+				min = max = *first;
+				for (It it = first; it != last; ++it) {
+					min = *it < min ? *it : min;
+					max = max < *it ? *it : max;
+				}
+			}
+			if (max > min) {
+				const double scale = 1.0 / (static_cast<double>(max) - static_cast<double>(min));
+				bulk_affine(first, last, scale, -static_cast<double>(min) * scale);
+			} else {
+				bulk_fill(first, last, T(0));
+			}
+		}
+
+		template<typename Container, typename F>
+		void bulk_apply(Container& value, F&& kernel) {
+			if constexpr (is_contiguous_storage_v<Container>) {
+				kernel(value.data(), value.data() + value.size());
+			} else {
+				kernel(value.begin(), value.end());
+			}
+		}
+
+		/* Operands typed in the bulk menu, kept in the widget store while it is open */
+		template<typename T>
+		struct bulk_state {
+			T fill{};
+			double scale = 1.0;
+			T offset{};
+		};
+
+		/* Right-click menu on the container label, returns the number of elements changed */
+		template<typename Container, typename Settings>
+		std::size_t bulk_menu(Container& value, std::size_t size, Settings& settings) {
+			using T = typename Container::value_type;
+			const ImGuiID menu_id = ImGui::GetID("bulk_operations");
+			if (!ImGui::BeginPopupContextItem("bulk_operations")) return 0;
+
+			bulk_state<T>& state = widget_store::current().get<bulk_state<T>>(menu_id);
+			auto& element_settings = settings.template get<T>();
+			/* Reaches the journal as one replace, taken before the operands suspend it */
+			scope_replace<Container> replace("bulk operation", value);
+			const scope_suspend_journal suspend; /* operands live in the widget store */
+			ImResponse scratch;
+			bool applied = false;
+
+			ImGui::TextDisabled("%zu elements", size);
+			ImGui::Separator();
+			if (ImGui::BeginMenu("Fill")) {
+				ImReflect::Input("value", state.fill, settings, scratch);
+				if (ImGui::MenuItem("Apply")) {
+					replace.capture();
+					bulk_apply(value, [&](auto first, auto last) { bulk_fill(first, last, state.fill); });
+					applied = true;
+				}
+				ImGui::EndMenu();
+			}
+			if (ImGui::BeginMenu("Scale")) {
+				ImGui::InputDouble("factor", &state.scale);
+				if (ImGui::MenuItem("Apply")) {
+					replace.capture();
+					bulk_apply(value, [&](auto first, auto last) { bulk_affine(first, last, state.scale, 0.0); });
+					applied = true;
+				}
+				ImGui::EndMenu();
+			}
+			if (ImGui::BeginMenu("Offset")) {
+				ImReflect::Input("amount", state.offset, settings, scratch);
+				if (ImGui::MenuItem("Apply")) {
+					replace.capture();
+					bulk_apply(value, [&](auto first, auto last) { bulk_affine(first, last, 1.0, static_cast<double>(state.offset)); });
+					applied = true;
+				}
+				ImGui::EndMenu();
+			}
+			if (ImGui::MenuItem("Clamp to min/max")) {
+				replace.capture();
+				const T lo = element_settings.get_min();
+				const T hi = element_settings.get_max();
+				bulk_apply(value, [&](auto first, auto last) { bulk_clamp(first, last, lo, hi); });
+				applied = true;
+			}
+			imgui_tooltip("Clamp every element to the min and max of the element settings");
+			if constexpr (std::is_floating_point_v<T>) {
+				if (ImGui::MenuItem("Normalize")) {
+					replace.capture();
+					bulk_apply(value, [&](auto first, auto last) { bulk_normalize(first, last); });
+					applied = true;
+				}
+				imgui_tooltip("Rescale so the smallest element is 0 and the largest 1");
+			} else {
+				ImGui::BeginDisabled();
+				ImGui::MenuItem("Normalize");
+				ImGui::EndDisabled();
+				imgui_tooltip("Only floating point elements can be normalized");
+			}
+			if (ImGui::MenuItem("Sort ascending")) {
+				replace.capture();
+				if constexpr (container_traits<Container>::has_random_access) std::sort(value.begin(), value.end());
+				else value.sort();
+				applied = true;
+			}
+
+			ImGui::EndPopup();
+			return applied ? size : 0;
+		}
+
+		/* ========================= Memory view ========================= */
+
+		template<typename T>
+		constexpr bool is_byte_like_v = sizeof(T) == 1 &&
+			((std::is_integral_v<T> && !std::is_same_v<T, bool>) || std::is_same_v<T, std::byte>);
+
+		constexpr std::size_t no_address = static_cast<std::size_t>(-1);
+
+		/* memchr finds the candidates for the first byte, C libraries scan with vector instructions */
+		inline std::size_t find_bytes(const unsigned char* data, std::size_t size, const std::vector<unsigned char>& pattern, std::size_t from) {
+			if (pattern.empty() || pattern.size() > size) return no_address;
+			const std::size_t last = size - pattern.size();
+			std::size_t at = from;
+			while (at <= last) {
+				const void* hit = std::memchr(data + at, pattern[0], last - at + 1);
+				if (!hit) break;
+				at = static_cast<std::size_t>(static_cast<const unsigned char*>(hit) - data);
+				if (std::memcmp(data + at, pattern.data(), pattern.size()) == 0) return at;
+				++at;
+			}
+			return no_address;
+		}
+
+		/* "DE AD be ef" to bytes, false on anything but hex digits and spaces or an odd digit count */
+		inline bool parse_hex_bytes(const std::string& text, std::vector<unsigned char>& bytes) {
+			bytes.clear();
+			int high = -1;
+			for (const char c : text) {
+				int digit;
+				if (c >= '0' && c <= '9') digit = c - '0';
+				else if (c >= 'a' && c <= 'f') digit = c - 'a' + 10;
+				else if (c >= 'A' && c <= 'F') digit = c - 'A' + 10;
+				else if (c == ' ') continue;
+				else return false;
+				if (high < 0) {
+					high = digit;
+				} else {
+					bytes.push_back(static_cast<unsigned char>(high * 16 + digit));
+					high = -1;
+				}
+			}
+			return high < 0;
+		}
+
+		/* Kept in the widget store */
+		struct memory_view_state {
+			std::size_t edit = no_address;    /* byte being typed over */
+			bool focus_edit = false;
+			char edit_buffer[3] = {};
+			std::string search;
+			bool search_hex = true;
+			const char* search_error = nullptr;
+			std::size_t match = no_address;
+			std::size_t match_size = 0;
+			bool scroll_to_match = false;
+		};
+
+		/* Returns the address of the byte written this frame, or ``no_address`` */
+		template<typename Container, typename Settings>
+		std::size_t draw_memory_view(Container& value, const Settings& settings, memory_view_state& state) {
+			constexpr bool read_only = std::is_const_v<Container>;
+			using byte_t = std::conditional_t<read_only, const unsigned char, unsigned char>;
+			byte_t* const data = reinterpret_cast<byte_t*>(value.data());
+			const std::size_t size = value.size();
+			const std::size_t per_row = static_cast<std::size_t>(std::clamp(settings.get_bytes_per_row(), 1, 64));
+			const std::size_t rows = (size + per_row - 1) / per_row;
+			std::size_t written = no_address;
+
+			/* Search */
+			const auto find = [&](std::size_t from) {
+				std::vector<unsigned char> pattern;
+				if (state.search_hex) {
+					if (!parse_hex_bytes(state.search, pattern)) {
+						state.search_error = "hex digits and spaces only, two digits per byte";
+						return;
+					}
+				} else {
+					pattern.assign(state.search.begin(), state.search.end());
+				}
+				state.search_error = nullptr;
+				std::size_t found = find_bytes(data, size, pattern, from);
+				if (found == no_address && from > 0) found = find_bytes(data, size, pattern, 0); /* wrap around */
+				state.match = found;
+				state.match_size = found == no_address ? 0 : pattern.size();
+				state.scroll_to_match = found != no_address;
+				if (found == no_address) state.search_error = "not found";
+				};
+			ImGui::SetNextItemWidth(ImGui::GetFontSize() * 12.0f);
+			if (ImGui::InputText("##search", &state.search, ImGuiInputTextFlags_EnterReturnsTrue)) {
+				find(state.match == no_address ? 0 : state.match + 1);
+			}
+			ImGui::SameLine();
+			if (ImGui::Button("Find next")) find(state.match == no_address ? 0 : state.match + 1);
+			ImGui::SameLine();
+			ImGui::Checkbox("hex", &state.search_hex);
+			if (state.search_error) {
+				ImGui::SameLine();
+				ImGui::TextDisabled("%s", state.search_error);
+			} else if (state.match != no_address) {
+				ImGui::SameLine();
+				ImGui::TextDisabled("at %zX", state.match);
+			}
+
+			/* Rows, only the visible ones are drawn */
+			const float row_height = ImGui::GetTextLineHeightWithSpacing();
+			const int visible_rows = std::max(settings.get_memory_view_rows(), 1);
+			ImGui::BeginChild("##memory", ImVec2(0.0f, row_height * static_cast<float>(visible_rows) + ImGui::GetStyle().WindowPadding.y * 2.0f), true);
+			if (state.scroll_to_match) {
+				ImGui::SetScrollY(static_cast<float>(state.match / per_row) * row_height);
+				state.scroll_to_match = false;
+			}
+
+			const float glyph = ImGui::CalcTextSize("F").x;
+			const float cell = glyph * 3.0f;
+			const float hex_x = ImGui::GetCursorPosX() + glyph * 10.0f;
+			const float ascii_x = hex_x + cell * static_cast<float>(per_row) + glyph;
+			const ImVec4 match_color = ImGui::GetStyle().Colors[ImGuiCol_PlotHistogram];
+			std::string ascii(per_row, ' ');
+
+			ImGui::PushStyleVar(ImGuiStyleVar_FramePadding, ImVec2(0.0f, 0.0f));
+			ImGuiListClipper clipper;
+			clipper.Begin(static_cast<int>(rows), row_height);
+			while (clipper.Step()) {
+				for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row) {
+					const std::size_t begin = static_cast<std::size_t>(row) * per_row;
+					const std::size_t end = std::min(begin + per_row, size);
+					ImGui::TextDisabled("%08zX", begin);
+
+					for (std::size_t address = begin; address < end; ++address) {
+						ImGui::SameLine(hex_x + cell * static_cast<float>(address - begin));
+						const unsigned char byte = data[address];
+						if constexpr (!read_only) {
+							if (state.edit == address) {
+								ImGui::PushID(static_cast<int>(address % per_row));
+								if (state.focus_edit) {
+									ImGui::SetKeyboardFocusHere();
+									std::snprintf(state.edit_buffer, sizeof(state.edit_buffer), "%02X", byte);
+									state.focus_edit = false;
+								}
+								ImGui::SetNextItemWidth(glyph * 2.0f);
+								const ImGuiInputTextFlags flags = ImGuiInputTextFlags_CharsHexadecimal | ImGuiInputTextFlags_AutoSelectAll |
+									ImGuiInputTextFlags_AlwaysOverwrite | ImGuiInputTextFlags_NoHorizontalScroll;
+								ImGui::InputText("##byte", state.edit_buffer, sizeof(state.edit_buffer), flags);
+								if (std::strlen(state.edit_buffer) == 2 && ImGui::IsItemEdited()) {
+									/* Two digits typed, write and move on to the next byte */
+									using element_t = typename Container::value_type;
+									element_t* const element = value.data() + address;
+									const element_t before = *element;
+									data[address] = static_cast<unsigned char>(std::strtoul(state.edit_buffer, nullptr, 16));
+									if (edit_journal* const journal = active_journal()) {
+										journal->on_leaf("memory view", element, journal_codec_of<element_t>(), &before, true, false, true);
+									}
+									written = address;
+									state.edit = address + 1 < size ? address + 1 : no_address;
+									state.focus_edit = true;
+								} else if (ImGui::IsItemDeactivated() && !state.focus_edit) {
+									state.edit = no_address;
+								}
+								ImGui::PopID();
+								continue;
+							}
+						}
+						const bool matched = address - state.match < state.match_size;
+						if (matched) ImGui::TextColored(match_color, "%02X", byte);
+						else ImGui::Text("%02X", byte);
+						if constexpr (!read_only) {
+							if (ImGui::IsItemClicked()) {
+								state.edit = address;
+								state.focus_edit = true;
+							}
+						}
+						if (ImGui::IsItemHovered()) ImGui::SetTooltip("%zX: %u", address, static_cast<unsigned>(byte));
+					}
+
+					for (std::size_t address = begin; address < end; ++address) {
+						const unsigned char byte = data[address];
+						ascii[address - begin] = byte >= 32 && byte < 127 ? static_cast<char>(byte) : '.';
+					}
+					ImGui::SameLine(ascii_x);
+					ImGui::TextUnformatted(ascii.data(), ascii.data() + (end - begin));
+				}
+			}
+			clipper.End();
+			ImGui::PopStyleVar();
+			ImGui::EndChild();
+			return written;
+		}
+
+		/* Popup state of a container widget, kept in the widget store under the popup id */
+		template<typename T>
+		struct container_insert_state {
+			static constexpr std::size_t at_end = static_cast<std::size_t>(-1);
+			std::size_t insert_index = at_end; /* index instead of an iterator, the container may reallocate while the popup is open */
+			T value{};
+		};
+
 		/*  Generic container input function */
 		template<typename Tag, typename Container, bool is_const, bool allow_insert, bool allow_remove, bool allow_reorder, bool allow_copy>
 		void container_input(const char* label, const Container& original_value, ImReflect::ImSettings& settings, ImReflect::ImResponse& response) {
@@ -598,6 +1512,8 @@ namespace ImReflect {
 
 			/* Get non-const reference if possible */
 			auto& value = get_container_value<Container, is_const>(original_value);
+			/* Shape changes reach the undo journal/recorder as one replace of the container */
+			Detail::scope_replace<std::remove_reference_t<decltype(value)>> replace(label, value);
 
 			constexpr bool default_constructible = std::is_default_constructible_v<T>;
 			constexpr bool copy_constructible = std::is_copy_constructible_v<T>;
@@ -630,8 +1546,11 @@ namespace ImReflect {
 
 			const auto id = Detail::scope_id("container");
 			const auto pop_up_id = ImGui::GetID("add_item_popup");
-
-			static auto insert_item = value.end();
+			const auto summary_id = ImGui::GetID("summary");
+			const auto plot_id = ImGui::GetID("plot");
+			const auto memory_id = ImGui::GetID("memory_view");
+			using insert_state = container_insert_state<T>;
+			const std::size_t change_count = vec_response.change_count();
 
 			ImReflect::Detail::text_label(label);
 			size_t item_count = 0;
@@ -640,6 +1559,17 @@ namespace ImReflect {
 			} else {
 			}
 
+			/*  Bulk operations, right-click on the label */
+			constexpr bool can_bulk = std::is_arithmetic_v<T> && !std::is_same_v<T, bool> && !is_const && !is_associative;
+			if constexpr (can_bulk) {
+				std::size_t size = item_count;
+				if constexpr (!has_size) size = static_cast<std::size_t>(std::distance(value.begin(), value.end()));
+				if (const std::size_t changed = bulk_menu(value, size, vec_settings); changed > 0) {
+					vec_response.changed();
+					vec_response.changed_range(0, changed);
+				}
+			}
+
 			const auto disabled_plus_button = []() {
 				ImGui::SameLine();
 				ImGui::BeginDisabled();
@@ -658,9 +1588,10 @@ namespace ImReflect {
 					ImGui::SameLine();
 					if (ImGui::Button("+")) {
 						if (vec_settings.is_pop_up_on_insert()) {
-							insert_item = value.end();
+							Detail::widget_store::current().get<insert_state>(pop_up_id).insert_index = insert_state::at_end;
 							ImGui::OpenPopup(pop_up_id);
 						} else {
+							replace.capture();
 							if constexpr (traits::has_push_back) {
 								value.push_back(T{});
 								vec_response.changed();
@@ -703,6 +1634,7 @@ namespace ImReflect {
 					if (item_count > 0 || traits::has_pop_front) {
 						ImGui::SameLine();
 						if (ImGui::Button("-")) {
+							replace.capture();
 							if constexpr (traits::has_erase) {
 								auto it = value.end();
 								--it;
@@ -724,6 +1656,55 @@ namespace ImReflect {
 				disabled_minus_button();
 			}
 
+			/*  Summary */
+			constexpr bool can_summarize = std::is_arithmetic_v<T> && !std::is_same_v<T, bool> &&
+				std::is_base_of_v<summary_mixin<Tag>, std::remove_reference_t<decltype(vec_settings)>>;
+			if constexpr (can_summarize) {
+				if (vec_settings.has_summary()) {
+					std::size_t size = item_count;
+					if constexpr (!has_size) size = static_cast<std::size_t>(std::distance(value.begin(), value.end()));
+					draw_container_summary(value, size, vec_settings, widget_store::current().get<summary_state>(summary_id));
+				}
+			}
+
+			constexpr bool can_plot = std::is_arithmetic_v<T> && !std::is_same_v<T, bool> &&
+				is_contiguous_storage_v<Container> &&
+				std::is_base_of_v<plot_mixin<Tag>, std::remove_reference_t<decltype(vec_settings)>>;
+
+			/*  Edits made here may fall between the checksum samples */
+			const auto invalidate_caches = [&]() {
+				if (vec_response.change_count() != change_count) {
+					if constexpr (can_plot) ++container_edits_of(&value).count; /* plots of it elsewhere */
+					if (summary_state* summary = widget_store::current().find<summary_state>(summary_id)) summary->valid = false;
+					if (plot_state* plot = widget_store::current().find<plot_state>(plot_id)) plot->valid = false;
+				}
+				};
+
+			/*  Memory view instead of the items */
+			constexpr bool can_memory_view = is_byte_like_v<T> &&
+				is_contiguous_storage_v<Container> &&
+				std::is_base_of_v<memory_view_mixin<Tag>, std::remove_reference_t<decltype(vec_settings)>>;
+			if constexpr (can_memory_view) {
+				if (vec_settings.is_memory_view()) {
+					const std::size_t written = draw_memory_view(value, vec_settings, widget_store::current().get<memory_view_state>(memory_id));
+					if (written != no_address) {
+						vec_response.changed();
+						vec_response.changed_range(written, written + 1);
+					}
+					invalidate_caches();
+					return;
+				}
+			}
+
+			/*  Plot instead of the items */
+			if constexpr (can_plot) {
+				if (vec_settings.is_plot() || vec_settings.is_plot_histogram()) {
+					invalidate_caches();
+					draw_container_plot(value, vec_settings, widget_store::current().get<plot_state>(plot_id));
+					return;
+				}
+			}
+
 			bool is_open = true;
 			if (is_dropdown) {
 				is_open = ImGui::TreeNodeEx(VECTOR_TREE_LABEL, ImGuiTreeNodeFlags_DefaultOpen | ImGuiTreeNodeFlags_SpanFullWidth);
@@ -744,6 +1725,7 @@ namespace ImReflect {
 								int target_idx = 0;
 
 								if (source_idx != target_idx) {
+									replace.capture();
 									auto src_it = value.begin();
 									std::advance(src_it, source_idx);
 									std::rotate(value.begin(), src_it, std::next(src_it));
@@ -759,6 +1741,16 @@ namespace ImReflect {
 				/*  Iterate through items */
 				int i = 0;
 				for (auto it = value.begin(); it != value.end(); ++it, ++i) {
+					if (!Detail::is_field_visible(*it)) continue;
+					if (!Detail::consume_budget()) {
+						if constexpr (has_size) {
+							Detail::budget_placeholder(static_cast<std::size_t>(value.size()) - i);
+						} else {
+							Detail::budget_placeholder(0);
+						}
+						break;
+					}
+
 					const auto item_id = Detail::scope_id(i);
 					const auto indent = Detail::scope_indent();
 
@@ -803,6 +1795,7 @@ namespace ImReflect {
 									int target_idx = i + 1;
 
 									if (source_idx != target_idx) {
+										replace.capture();
 										auto src_it = value.begin();
 										std::advance(src_it, source_idx);
 										auto tgt_it = value.begin();
@@ -833,6 +1826,7 @@ namespace ImReflect {
 						/*  Remove item */
 						if constexpr (can_remove) {
 							if (vec_settings.is_removable() && ImGui::MenuItem("Remove item")) {
+								replace.capture();
 								//value.erase(it);
 								if constexpr (traits::has_erase) {
 									it = value.erase(it);
@@ -857,6 +1851,7 @@ namespace ImReflect {
 						/*  Duplicate item */
 						if constexpr (can_copy) {
 							if (vec_settings.is_insertable() && ImGui::MenuItem("Duplicate item")) {
+								replace.capture();
 								if constexpr (traits::push_front) {
 									value.push_front(*it);
 								} else {
@@ -876,16 +1871,37 @@ namespace ImReflect {
 
 						ImGui::Separator();
 
+						/*  Clipboard */
+						if (Detail::clipboard_menu_items(*it, "Copy item", "Paste item")) {
+							vec_response.changed();
+						}
+						if constexpr (!is_const && !is_associative) {
+							/*  Parsed once and copied onto every item, no widgets involved */
+							if (ImGui::MenuItem("Paste to all items", nullptr, false, Detail::clipboard_has<T>())) {
+								replace.capture();
+								if (Detail::clipboard_paste_each(value)) vec_response.changed();
+							}
+						}
+						if (Detail::clipboard_menu_items(value, "Copy all", "Paste all")) {
+							vec_response.changed();
+							ImGui::EndPopup();
+							break;
+						}
+
+						ImGui::Separator();
+
 						/*  Move operations */
 						if constexpr (can_reorder) {
 							if (vec_settings.is_reorderable()) {
 								if (ImGui::MenuItem("Move up") && i != 0) {
+									replace.capture();
 									auto prev_it = std::prev(it);
 									std::iter_swap(it, prev_it);
 									vec_response.changed();
 									vec_response.moved_index(i, i - 1);
 								}
 								if (ImGui::MenuItem("Move down") && i != static_cast<int>(item_count) - 1) {
+									replace.capture();
 									auto next_it = std::next(it);
 									std::iter_swap(it, next_it);
 									vec_response.changed();
@@ -894,11 +1910,13 @@ namespace ImReflect {
 								ImGui::Separator();
 
 								if (ImGui::MenuItem("Move to top") && i != 0) {
+									replace.capture();
 									std::rotate(value.begin(), it, std::next(it));
 									vec_response.changed();
 									vec_response.moved_index(i, 0);
 								}
 								if (ImGui::MenuItem("Move to bottom") && i != static_cast<int>(item_count) - 1) {
+									replace.capture();
 									std::rotate(it, std::next(it), value.end());
 									vec_response.changed();
 									vec_response.moved_index(i, item_count - 1);
@@ -912,9 +1930,10 @@ namespace ImReflect {
 							if (vec_settings.is_insertable() && ImGui::MenuItem("Insert above")) {
 								if constexpr (supports_duplicate) {
 									if (vec_settings.is_pop_up_on_insert()) {
-										insert_item = it;
+										Detail::widget_store::current().get<insert_state>(pop_up_id).insert_index = static_cast<std::size_t>(i);
 										ImGui::OpenPopup(pop_up_id);
 									} else {
+										replace.capture();
 										/*value.insert(it, T());
 										vec_response.changed();*/
 										if constexpr (traits::has_push_back) {
@@ -939,9 +1958,10 @@ namespace ImReflect {
 								if constexpr (supports_duplicate) {
 									auto next_it = std::next(it);
 									if (vec_settings.is_pop_up_on_insert()) {
-										insert_item = next_it;
+										Detail::widget_store::current().get<insert_state>(pop_up_id).insert_index = static_cast<std::size_t>(i) + 1;
 										ImGui::OpenPopup(pop_up_id);
 									} else {
+										replace.capture();
 										/*value.insert(next_it, T());
 										vec_response.changed();*/
 										if constexpr (traits::has_push_back) {
@@ -981,6 +2001,7 @@ namespace ImReflect {
 						/*  Clear all */
 						if constexpr (can_remove) {
 							if (vec_settings.is_removable() && ImGui::MenuItem("Clear all")) {
+								replace.capture();
 								value.clear();
 								vec_response.changed();
 								ImGui::EndPopup();
@@ -1002,13 +2023,19 @@ namespace ImReflect {
 				if constexpr (can_insert) {
 					if (ImGui::BeginPopupEx(pop_up_id, ImGuiWindowFlags_AlwaysAutoResize | ImGuiWindowFlags_NoTitleBar | ImGuiWindowFlags_NoSavedSettings)) {
 
-						static T temp_value{};
+						insert_state& state = Detail::widget_store::current().get<insert_state>(pop_up_id);
+						T& temp_value = state.value;
 
 						if (ImGui::MenuItem("Add new item")) {
+							replace.capture();
+							auto insert_item = value.begin();
+							std::size_t insert_index = 0;
+							for (; insert_index < state.insert_index && insert_item != value.end(); ++insert_index) ++insert_item;
+
 							if (insert_item != value.end()) {
 								if constexpr (traits::has_insert) {
 									value.insert(insert_item, temp_value);
-									vec_response.inserted_index(value.size() - 1);
+									vec_response.inserted_index(insert_index);
 								} else if constexpr (traits::has_push_back) {
 									value.push_back(temp_value);
 									vec_response.inserted_index(value.size() - 1);
@@ -1030,10 +2057,11 @@ namespace ImReflect {
 							}
 							vec_response.changed();
 							temp_value = T{};
-							insert_item = value.end();
+							state.insert_index = insert_state::at_end;
 							ImGui::CloseCurrentPopup();
 						}
 
+						const Detail::scope_suspend_journal suspend; /* the new item lives in the widget store */
 						ImReflect::Input("##new_item_input", temp_value, vec_settings, vec_response);
 
 						ImGui::EndPopup();
@@ -1046,6 +2074,8 @@ namespace ImReflect {
 			if (is_dropdown && is_open) {
 				ImGui::TreePop();
 			}
+
+			invalidate_caches();
 		}
 	}
 
@@ -1057,7 +2087,10 @@ namespace ImReflect {
 		ImReflect::Detail::dropdown<std_vector>,
 		ImReflect::Detail::reorderable_mixin<std_vector>,
 		ImReflect::Detail::insertable_mixin<std_vector>,
-		ImReflect::Detail::removable_mixin<std_vector> {
+		ImReflect::Detail::removable_mixin<std_vector>,
+		ImReflect::Detail::summary_mixin<std_vector>,
+		ImReflect::Detail::plot_mixin<std_vector>,
+		ImReflect::Detail::memory_view_mixin<std_vector> {
 	};
 
 	template<>
@@ -1066,26 +2099,26 @@ namespace ImReflect {
 		ImReflect::Detail::container_response {
 	};
 
-	template<typename T>
-	void tag_invoke(Detail::ImInputLib_t, const char* label, std::vector<T>& value, ImSettings& settings, ImResponse& response) {
+	template<typename T, typename Alloc>
+	void tag_invoke(Detail::ImInputLib_t, const char* label, std::vector<T, Alloc>& value, ImSettings& settings, ImResponse& response) {
 		constexpr bool is_const = false;
 		constexpr bool allow_insert = true;
 		constexpr bool allow_remove = true;
 		constexpr bool all_reorder = true;
 		constexpr bool allow_copy = true;
 
-		Detail::container_input<std_vector, std::vector<T>, is_const, allow_insert, allow_remove, all_reorder, allow_copy>(label, value, settings, response);
+		Detail::container_input<std_vector, std::vector<T, Alloc>, is_const, allow_insert, allow_remove, all_reorder, allow_copy>(label, value, settings, response);
 	}
 
-	template<typename T>
-	void tag_invoke(Detail::ImInputLib_t, const char* label, const std::vector<T>& value, ImSettings& settings, ImResponse& response) {
+	template<typename T, typename Alloc>
+	void tag_invoke(Detail::ImInputLib_t, const char* label, const std::vector<T, Alloc>& value, ImSettings& settings, ImResponse& response) {
 		constexpr bool is_const = true;
 		constexpr bool allow_insert = false;
 		constexpr bool allow_remove = false;
 		constexpr bool all_reorder = false;
 		constexpr bool allow_copy = false;
 
-		Detail::container_input<std_vector, std::vector<T>, is_const, allow_insert, allow_remove, all_reorder, allow_copy>(label, value, settings, response);
+		Detail::container_input<std_vector, std::vector<T, Alloc>, is_const, allow_insert, allow_remove, all_reorder, allow_copy>(label, value, settings, response);
 	}
 
 	/* ========================= std::array ========================= */
@@ -1094,7 +2127,10 @@ namespace ImReflect {
 	template<>
 	struct type_settings<std_array> : ImRequired<std_array>,
 		ImReflect::Detail::dropdown<std_array>,
-		ImReflect::Detail::reorderable_mixin<std_array> {
+		ImReflect::Detail::reorderable_mixin<std_array>,
+		ImReflect::Detail::summary_mixin<std_array>,
+		ImReflect::Detail::plot_mixin<std_array>,
+		ImReflect::Detail::memory_view_mixin<std_array> {
 	};
 
 	template<>
@@ -1125,6 +2161,97 @@ namespace ImReflect {
 		Detail::container_input<std_array, std::array<T, N>, is_const, allow_insert, allow_remove, allow_reorder, allow_copy>(label, value, settings, response);
 	}
 
+	/* ========================= External memory: ImReflect::array_view, std::span, C arrays ========================= */
+	/*
+	* Pointer and size of memory owned by someone else. Edited in place like a std::array, nothing is copied.
+	* Constness propagates: a const view only hands out const elements.
+	*/
+	template<typename T>
+	class array_view {
+	public:
+		using value_type = std::remove_cv_t<T>;
+		using iterator = T*;
+		using const_iterator = const T*;
+
+		array_view() = default;
+		array_view(T* data, std::size_t size) : _data(data), _size(size) {}
+		template<std::size_t N>
+		array_view(T(&data)[N]) : _data(data), _size(N) {}
+
+		T* data() { return _data; }
+		const T* data() const { return _data; }
+		std::size_t size() const { return _size; }
+		bool empty() const { return _size == 0; }
+
+		T& operator[](std::size_t i) { return _data[i]; }
+		const T& operator[](std::size_t i) const { return _data[i]; }
+
+		iterator begin() { return _data; }
+		iterator end() { return _data + _size; }
+		const_iterator begin() const { return _data; }
+		const_iterator end() const { return _data + _size; }
+
+	private:
+		T* _data = nullptr;
+		std::size_t _size = 0;
+	};
+
+	struct std_span {};
+
+	template<>
+	struct type_settings<std_span> : ImRequired<std_span>,
+		ImReflect::Detail::dropdown<std_span>,
+		ImReflect::Detail::reorderable_mixin<std_span>,
+		ImReflect::Detail::summary_mixin<std_span>,
+		ImReflect::Detail::plot_mixin<std_span>,
+		ImReflect::Detail::memory_view_mixin<std_span> {
+	};
+
+	template<>
+	struct type_response<std_span> :
+		ImReflect::Detail::required_response<std_span>,
+		ImReflect::Detail::container_response {
+	};
+
+	namespace Detail {
+		/* Every external memory type ends up here, with the fixed size path of container_input */
+		template<typename T>
+		void array_view_input(const char* label, T* data, std::size_t size, ImSettings& settings, ImResponse& response) {
+			using U = std::remove_const_t<T>;
+			constexpr bool is_const = std::is_const_v<T>;
+			constexpr bool allow_insert = false;
+			constexpr bool allow_remove = false;
+			constexpr bool allow_reorder = !is_const;
+			constexpr bool allow_copy = false;
+
+			std::conditional_t<is_const, const array_view<U>, array_view<U>> view(const_cast<U*>(data), size);
+			container_input<std_span, array_view<U>, is_const, allow_insert, allow_remove, allow_reorder, allow_copy>(label, view, settings, response);
+		}
+	}
+
+	template<typename T>
+	void tag_invoke(Detail::ImInputLib_t, const char* label, array_view<T>& value, ImSettings& settings, ImResponse& response) {
+		Detail::array_view_input(label, value.data(), value.size(), settings, response);
+	}
+
+	template<typename T>
+	void tag_invoke(Detail::ImInputLib_t, const char* label, const array_view<T>& value, ImSettings& settings, ImResponse& response) {
+		Detail::array_view_input(label, value.data(), value.size(), settings, response);
+	}
+
+	template<typename T, std::size_t N>
+	void tag_invoke(Detail::ImInputLib_t, const char* label, T(&value)[N], ImSettings& settings, ImResponse& response) {
+		Detail::array_view_input(label, value, N, settings, response);
+	}
+
+#if __cplusplus >= 202002L || (defined(_MSVC_LANG) && _MSVC_LANG >= 202002L)
+	/* A const span still points to mutable elements, only span<const T> is read only */
+	template<typename T, std::size_t Extent>
+	void tag_invoke(Detail::ImInputLib_t, const char* label, const std::span<T, Extent>& value, ImSettings& settings, ImResponse& response) {
+		Detail::array_view_input(label, value.data(), value.size(), settings, response);
+	}
+#endif
+
 	/* ========================= std::list ========================= */
 	struct std_list {};
 
@@ -1133,7 +2260,8 @@ namespace ImReflect {
 		ImReflect::Detail::dropdown<std_list>,
 		ImReflect::Detail::reorderable_mixin<std_list>,
 		ImReflect::Detail::insertable_mixin<std_list>,
-		ImReflect::Detail::removable_mixin<std_list> {
+		ImReflect::Detail::removable_mixin<std_list>,
+		ImReflect::Detail::summary_mixin<std_list> {
 	};
 
 	template<>
@@ -1142,26 +2270,26 @@ namespace ImReflect {
 		ImReflect::Detail::container_response {
 	};
 
-	template<typename T>
-	void tag_invoke(Detail::ImInputLib_t, const char* label, std::list<T>& value, ImSettings& settings, ImResponse& response) {
+	template<typename T, typename Alloc>
+	void tag_invoke(Detail::ImInputLib_t, const char* label, std::list<T, Alloc>& value, ImSettings& settings, ImResponse& response) {
 		constexpr bool is_const = false;
 		constexpr bool allow_insert = true;
 		constexpr bool allow_remove = true;
 		constexpr bool allow_reorder = true;
 		constexpr bool allow_copy = true;
 
-		Detail::container_input<std_list, std::list<T>, is_const, allow_insert, allow_remove, allow_reorder, allow_copy>(label, value, settings, response);
+		Detail::container_input<std_list, std::list<T, Alloc>, is_const, allow_insert, allow_remove, allow_reorder, allow_copy>(label, value, settings, response);
 	}
 
-	template<typename T>
-	void tag_invoke(Detail::ImInputLib_t, const char* label, const std::list<T>& value, ImSettings& settings, ImResponse& response) {
+	template<typename T, typename Alloc>
+	void tag_invoke(Detail::ImInputLib_t, const char* label, const std::list<T, Alloc>& value, ImSettings& settings, ImResponse& response) {
 		constexpr bool is_const = true;
 		constexpr bool allow_insert = false;
 		constexpr bool allow_remove = false;
 		constexpr bool allow_reorder = false;
 		constexpr bool allow_copy = false;
 
-		Detail::container_input<std_list, std::list<T>, is_const, allow_insert, allow_remove, allow_reorder, allow_copy>(label, value, settings, response);
+		Detail::container_input<std_list, std::list<T, Alloc>, is_const, allow_insert, allow_remove, allow_reorder, allow_copy>(label, value, settings, response);
 	}
 
 	/* ========================= std::forward_list ========================= */
@@ -1171,7 +2299,8 @@ namespace ImReflect {
 	struct type_settings<std_forward_list> : ImRequired<std_forward_list>,
 		ImReflect::Detail::dropdown<std_forward_list>,
 		ImReflect::Detail::insertable_mixin<std_forward_list>,
-		ImReflect::Detail::removable_mixin<std_forward_list> {
+		ImReflect::Detail::removable_mixin<std_forward_list>,
+		ImReflect::Detail::summary_mixin<std_forward_list> {
 	};
 
 	template<>
@@ -1180,24 +2309,24 @@ namespace ImReflect {
 		ImReflect::Detail::container_response {
 	};
 
-	template<typename T>
-	void tag_invoke(Detail::ImInputLib_t, const char* label, std::forward_list<T>& value, ImSettings& settings, ImResponse& response) {
+	template<typename T, typename Alloc>
+	void tag_invoke(Detail::ImInputLib_t, const char* label, std::forward_list<T, Alloc>& value, ImSettings& settings, ImResponse& response) {
 		constexpr bool is_const = false;
 		constexpr bool allow_insert = true;
 		constexpr bool allow_remove = true;
 		constexpr bool allow_reorder = false;
 		constexpr bool allow_copy = true;
-		Detail::container_input<std_forward_list, std::forward_list<T>, is_const, allow_insert, allow_remove, allow_reorder, allow_copy>(label, value, settings, response);
+		Detail::container_input<std_forward_list, std::forward_list<T, Alloc>, is_const, allow_insert, allow_remove, allow_reorder, allow_copy>(label, value, settings, response);
 	}
 
-	template<typename T>
-	void tag_invoke(Detail::ImInputLib_t, const char* label, const std::forward_list<T>& value, ImSettings& settings, ImResponse& response) {
+	template<typename T, typename Alloc>
+	void tag_invoke(Detail::ImInputLib_t, const char* label, const std::forward_list<T, Alloc>& value, ImSettings& settings, ImResponse& response) {
 		constexpr bool is_const = true;
 		constexpr bool allow_insert = false;
 		constexpr bool allow_remove = false;
 		constexpr bool allow_reorder = false;
 		constexpr bool allow_copy = false;
-		Detail::container_input<std_forward_list, std::forward_list<T>, is_const, allow_insert, allow_remove, allow_reorder, allow_copy>(label, value, settings, response);
+		Detail::container_input<std_forward_list, std::forward_list<T, Alloc>, is_const, allow_insert, allow_remove, allow_reorder, allow_copy>(label, value, settings, response);
 	}
 
 	/* ========================= std::deque ========================= */
@@ -1208,7 +2337,8 @@ namespace ImReflect {
 		ImReflect::Detail::dropdown<std_deque>,
 		ImReflect::Detail::reorderable_mixin<std_deque>,
 		ImReflect::Detail::insertable_mixin<std_deque>,
-		ImReflect::Detail::removable_mixin<std_deque> {
+		ImReflect::Detail::removable_mixin<std_deque>,
+		ImReflect::Detail::summary_mixin<std_deque> {
 	};
 
 	template<>
@@ -1217,26 +2347,26 @@ namespace ImReflect {
 		ImReflect::Detail::container_response {
 	};
 
-	template<typename T>
-	void tag_invoke(Detail::ImInputLib_t, const char* label, std::deque<T>& value, ImSettings& settings, ImResponse& response) {
+	template<typename T, typename Alloc>
+	void tag_invoke(Detail::ImInputLib_t, const char* label, std::deque<T, Alloc>& value, ImSettings& settings, ImResponse& response) {
 		constexpr bool is_const = false;
 		constexpr bool allow_insert = true;
 		constexpr bool allow_remove = true;
 		constexpr bool allow_reorder = true;
 		constexpr bool allow_copy = true;
 
-		Detail::container_input<std_deque, std::deque<T>, is_const, allow_insert, allow_remove, allow_reorder, allow_copy>(label, value, settings, response);
+		Detail::container_input<std_deque, std::deque<T, Alloc>, is_const, allow_insert, allow_remove, allow_reorder, allow_copy>(label, value, settings, response);
 	}
 
-	template<typename T>
-	void tag_invoke(Detail::ImInputLib_t, const char* label, const std::deque<T>& value, ImSettings& settings, ImResponse& response) {
+	template<typename T, typename Alloc>
+	void tag_invoke(Detail::ImInputLib_t, const char* label, const std::deque<T, Alloc>& value, ImSettings& settings, ImResponse& response) {
 		constexpr bool is_const = true;
 		constexpr bool allow_insert = false;
 		constexpr bool allow_remove = false;
 		constexpr bool allow_reorder = false;
 		constexpr bool allow_copy = false;
 
-		Detail::container_input<std_deque, std::deque<T>, is_const, allow_insert, allow_remove, allow_reorder, allow_copy>(label, value, settings, response);
+		Detail::container_input<std_deque, std::deque<T, Alloc>, is_const, allow_insert, allow_remove, allow_reorder, allow_copy>(label, value, settings, response);
 	}
 
 	/* ========================= std::set ========================= */
@@ -1255,26 +2385,26 @@ namespace ImReflect {
 		ImReflect::Detail::container_response {
 	};
 
-	template<typename T>
-	void tag_invoke(Detail::ImInputLib_t, const char* label, std::set<T>& value, ImSettings& settings, ImResponse& response) {
+	template<typename T, typename Compare, typename Alloc>
+	void tag_invoke(Detail::ImInputLib_t, const char* label, std::set<T, Compare, Alloc>& value, ImSettings& settings, ImResponse& response) {
 		constexpr bool is_const = false;
 		constexpr bool allow_insert = true;
 		constexpr bool allow_remove = true;
 		constexpr bool allow_reorder = false;
 		constexpr bool allow_copy = true;
 
-		Detail::container_input<std_set, std::set<T>, is_const, allow_insert, allow_remove, allow_reorder, allow_copy>(label, value, settings, response);
+		Detail::container_input<std_set, std::set<T, Compare, Alloc>, is_const, allow_insert, allow_remove, allow_reorder, allow_copy>(label, value, settings, response);
 	}
 
-	template<typename T>
-	void tag_invoke(Detail::ImInputLib_t, const char* label, const std::set<T>& value, ImSettings& settings, ImResponse& response) {
+	template<typename T, typename Compare, typename Alloc>
+	void tag_invoke(Detail::ImInputLib_t, const char* label, const std::set<T, Compare, Alloc>& value, ImSettings& settings, ImResponse& response) {
 		constexpr bool is_const = true;
 		constexpr bool allow_insert = false;
 		constexpr bool allow_remove = false;
 		constexpr bool allow_reorder = false;
 		constexpr bool allow_copy = false;
 
-		Detail::container_input<std_set, std::set<T>, is_const, allow_insert, allow_remove, allow_reorder, allow_copy>(label, value, settings, response);
+		Detail::container_input<std_set, std::set<T, Compare, Alloc>, is_const, allow_insert, allow_remove, allow_reorder, allow_copy>(label, value, settings, response);
 	}
 
 	/* ========================= std::unordered_set ========================= */
@@ -1293,24 +2423,24 @@ namespace ImReflect {
 		ImReflect::Detail::container_response {
 	};
 
-	template<typename T>
-	void tag_invoke(Detail::ImInputLib_t, const char* label, std::unordered_set<T>& value, ImSettings& settings, ImResponse& response) {
+	template<typename T, typename Hash, typename KeyEqual, typename Alloc>
+	void tag_invoke(Detail::ImInputLib_t, const char* label, std::unordered_set<T, Hash, KeyEqual, Alloc>& value, ImSettings& settings, ImResponse& response) {
 		constexpr bool is_const = false;
 		constexpr bool allow_insert = true;
 		constexpr bool allow_remove = true;
 		constexpr bool allow_reorder = false;
 		constexpr bool allow_copy = true;
-		Detail::container_input<std_unordered_set, std::unordered_set<T>, is_const, allow_insert, allow_remove, allow_reorder, allow_copy>(label, value, settings, response);
+		Detail::container_input<std_unordered_set, std::unordered_set<T, Hash, KeyEqual, Alloc>, is_const, allow_insert, allow_remove, allow_reorder, allow_copy>(label, value, settings, response);
 	}
 
-	template<typename T>
-	void tag_invoke(Detail::ImInputLib_t, const char* label, const std::unordered_set<T>& value, ImSettings& settings, ImResponse& response) {
+	template<typename T, typename Hash, typename KeyEqual, typename Alloc>
+	void tag_invoke(Detail::ImInputLib_t, const char* label, const std::unordered_set<T, Hash, KeyEqual, Alloc>& value, ImSettings& settings, ImResponse& response) {
 		constexpr bool is_const = true;
 		constexpr bool allow_insert = false;
 		constexpr bool allow_remove = false;
 		constexpr bool allow_reorder = false;
 		constexpr bool allow_copy = false;
-		Detail::container_input<std_unordered_set, std::unordered_set<T>, is_const, allow_insert, allow_remove, allow_reorder, allow_copy>(label, value, settings, response);
+		Detail::container_input<std_unordered_set, std::unordered_set<T, Hash, KeyEqual, Alloc>, is_const, allow_insert, allow_remove, allow_reorder, allow_copy>(label, value, settings, response);
 	}
 
 	/* ========================= std::multiset ========================= */
@@ -1329,26 +2459,26 @@ namespace ImReflect {
 		ImReflect::Detail::container_response {
 	};
 
-	template<typename T>
-	void tag_invoke(Detail::ImInputLib_t, const char* label, std::multiset<T>& value, ImSettings& settings, ImResponse& response) {
+	template<typename T, typename Compare, typename Alloc>
+	void tag_invoke(Detail::ImInputLib_t, const char* label, std::multiset<T, Compare, Alloc>& value, ImSettings& settings, ImResponse& response) {
 		constexpr bool is_const = false;
 		constexpr bool allow_insert = true;
 		constexpr bool allow_remove = true;
 		constexpr bool allow_reorder = false;
 		constexpr bool allow_copy = true;
 
-		Detail::container_input<std_multiset, std::multiset<T>, is_const, allow_insert, allow_remove, allow_reorder, allow_copy>(label, value, settings, response);
+		Detail::container_input<std_multiset, std::multiset<T, Compare, Alloc>, is_const, allow_insert, allow_remove, allow_reorder, allow_copy>(label, value, settings, response);
 	}
 
-	template<typename T>
-	void tag_invoke(Detail::ImInputLib_t, const char* label, const std::multiset<T>& value, ImSettings& settings, ImResponse& response) {
+	template<typename T, typename Compare, typename Alloc>
+	void tag_invoke(Detail::ImInputLib_t, const char* label, const std::multiset<T, Compare, Alloc>& value, ImSettings& settings, ImResponse& response) {
 		constexpr bool is_const = true;
 		constexpr bool allow_insert = false;
 		constexpr bool allow_remove = false;
 		constexpr bool allow_reorder = false;
 		constexpr bool allow_copy = false;
 
-		Detail::container_input<std_multiset, std::multiset<T>, is_const, allow_insert, allow_remove, allow_reorder, allow_copy>(label, value, settings, response);
+		Detail::container_input<std_multiset, std::multiset<T, Compare, Alloc>, is_const, allow_insert, allow_remove, allow_reorder, allow_copy>(label, value, settings, response);
 	}
 
 	/* ========================= std::unordered_multiset ========================= */
@@ -1367,24 +2497,24 @@ namespace ImReflect {
 		ImReflect::Detail::container_response {
 	};
 
-	template<typename T>
-	void tag_invoke(Detail::ImInputLib_t, const char* label, std::unordered_multiset<T>& value, ImSettings& settings, ImResponse& response) {
+	template<typename T, typename Hash, typename KeyEqual, typename Alloc>
+	void tag_invoke(Detail::ImInputLib_t, const char* label, std::unordered_multiset<T, Hash, KeyEqual, Alloc>& value, ImSettings& settings, ImResponse& response) {
 		constexpr bool is_const = false;
 		constexpr bool allow_insert = true;
 		constexpr bool allow_remove = true;
 		constexpr bool allow_reorder = false;
 		constexpr bool allow_copy = true;
-		Detail::container_input<std_unordered_multiset, std::unordered_multiset<T>, is_const, allow_insert, allow_remove, allow_reorder, allow_copy>(label, value, settings, response);
+		Detail::container_input<std_unordered_multiset, std::unordered_multiset<T, Hash, KeyEqual, Alloc>, is_const, allow_insert, allow_remove, allow_reorder, allow_copy>(label, value, settings, response);
 	}
 
-	template<typename T>
-	void tag_invoke(Detail::ImInputLib_t, const char* label, const std::unordered_multiset<T>& value, ImSettings& settings, ImResponse& response) {
+	template<typename T, typename Hash, typename KeyEqual, typename Alloc>
+	void tag_invoke(Detail::ImInputLib_t, const char* label, const std::unordered_multiset<T, Hash, KeyEqual, Alloc>& value, ImSettings& settings, ImResponse& response) {
 		constexpr bool is_const = true;
 		constexpr bool allow_insert = false;
 		constexpr bool allow_remove = false;
 		constexpr bool allow_reorder = false;
 		constexpr bool allow_copy = false;
-		Detail::container_input<std_unordered_multiset, std::unordered_multiset<T>, is_const, allow_insert, allow_remove, allow_reorder, allow_copy>(label, value, settings, response);
+		Detail::container_input<std_unordered_multiset, std::unordered_multiset<T, Hash, KeyEqual, Alloc>, is_const, allow_insert, allow_remove, allow_reorder, allow_copy>(label, value, settings, response);
 	}
 
 	/* ========================= Key / value container ========================= */
@@ -1407,6 +2537,13 @@ namespace ImReflect {
 			}
 		}
 
+		/* Popup state of a map widget, kept in the widget store under the popup id */
+		template<typename K, typename V>
+		struct map_insert_state {
+			K key{};
+			V value{};
+		};
+
 		/*  Generic map input function */
 		template<typename Tag, typename Container, bool is_const, bool allow_insert, bool allow_remove>
 		static void map_input(const char* label, const Container& original_value, ImSettings& settings, ImResponse& response) {
@@ -1419,6 +2556,8 @@ namespace ImReflect {
 
 			/* Get non-const reference if possible */
 			auto& value = get_map_value<Container, is_const>(original_value);
+			/* Entries added or removed reach the undo journal/recorder as one replace of the map */
+			Detail::scope_replace<std::remove_reference_t<decltype(value)>> replace(label, value);
 
 			const auto id = Detail::scope_id("map");
 			const auto pop_up_id = ImGui::GetID("add_map_item_popup");
@@ -1470,6 +2609,7 @@ namespace ImReflect {
                 if (!value.empty()) {
                     ImGui::SameLine();
 					if (ImGui::Button("-")) {
+						replace.capture();
 						auto it = value.end();
 						--it;
 						value.erase(it);
@@ -1482,10 +2622,16 @@ namespace ImReflect {
 			}
 
 			int i = 0;
-			for (auto it = value.begin(); it != value.end(); ++it) {
+			for (auto it = value.begin(); it != value.end(); ++it, ++i) {
 				const auto& key = it->first;
 				auto& val = it->second;
 
+				if (!Detail::is_field_visible(val)) continue;
+				if (!Detail::consume_budget()) {
+					Detail::budget_placeholder(static_cast<std::size_t>(value.size()) - i);
+					break;
+				}
+
 
 				auto pair = std::tie(key, val);
 
@@ -1508,6 +2654,7 @@ namespace ImReflect {
 					/*  Remove item */
 					if constexpr (can_remove) {
 						if (map_settings.is_removable() && ImGui::MenuItem("Remove item")) {
+							replace.capture();
 							value.erase(it);
 							map_response.changed();
 							ImGui::EndPopup();
@@ -1523,6 +2670,7 @@ namespace ImReflect {
 					/*  Clear all */
 					if constexpr (can_remove) {
 						if (map_settings.is_removable() && ImGui::MenuItem("Clear all")) {
+							replace.capture();
 							value.clear();
 							map_response.changed();
 							ImGui::EndPopup();
@@ -1535,26 +2683,58 @@ namespace ImReflect {
 						if constexpr (!copy_constructible) Detail::imgui_tooltip("Key or value type is not copy/move constructible or container is const, cannot remove item");
 						else Detail::imgui_tooltip("Container is const or removal disabled in settings, cannot remove item");
 					}
+
+					ImGui::Separator();
+
+					/*  Clipboard */
+					if (ImGui::MenuItem("Copy entry")) {
+						Detail::clipboard_copy(*it);
+					}
+					if constexpr (can_insert) {
+						if (map_settings.is_insertable() && ImGui::MenuItem("Paste entry", nullptr, false, Detail::clipboard_has<std::pair<K, V>>())) {
+							std::pair<K, V> entry{};
+							if (Detail::clipboard_paste(entry)) {
+								replace.capture();
+								if constexpr (Detail::allows_duplicate_keys_v<Container>) {
+									value.emplace(std::move(entry.first), std::move(entry.second));
+								} else {
+									value.insert_or_assign(std::move(entry.first), std::move(entry.second));
+								}
+								map_response.changed();
+								ImGui::EndPopup();
+								break;
+							}
+						}
+					}
+					if (Detail::clipboard_menu_items(val, "Copy value", "Paste value")) {
+						map_response.changed();
+					}
+					if (Detail::clipboard_menu_items(value, "Copy all", "Paste all")) {
+						map_response.changed();
+						ImGui::EndPopup();
+						break;
+					}
 					ImGui::EndPopup();
 				}
 
 				ImGui::Unindent();
-
-				++i;
 			}
 
 			/*  Add item popup */
 			if constexpr (can_insert) {
 				if (ImGui::BeginPopupEx(pop_up_id, ImGuiWindowFlags_AlwaysAutoResize | ImGuiWindowFlags_NoTitleBar | ImGuiWindowFlags_NoSavedSettings)) {
-					static K temp_key{};
-					static V temp_value{};
+					auto& state = Detail::widget_store::current().get<Detail::map_insert_state<K, V>>(pop_up_id);
+					K& temp_key = state.key;
+					V& temp_value = state.value;
 					if (ImGui::MenuItem("Add new item")) {
+						replace.capture();
 						value.emplace(temp_key, temp_value);
 						map_response.changed();
 						temp_key = K{};
 						temp_value = V{};
 						ImGui::CloseCurrentPopup();
 					}
+					const Detail::scope_suspend_journal suspend; /* the new entry lives in the widget store */
 					ImReflect::Input("##new_map_key", temp_key, map_settings, map_response);
 					ImReflect::Input("##new_map_value", temp_value, map_settings, map_response);
 					ImGui::EndPopup();
@@ -1574,22 +2754,22 @@ namespace ImReflect {
 		ImReflect::Detail::removable_mixin<std_map> {
 	};
 
-	template<typename K, typename V>
-	void tag_invoke(Detail::ImInputLib_t, const char* label, std::map<K, V>& value, ImSettings& settings, ImResponse& response) {
+	template<typename K, typename V, typename Compare, typename Alloc>
+	void tag_invoke(Detail::ImInputLib_t, const char* label, std::map<K, V, Compare, Alloc>& value, ImSettings& settings, ImResponse& response) {
 		constexpr bool is_const = false;
 		constexpr bool allow_insert = true;
 		constexpr bool allow_remove = true;
 
-		Detail::map_input<std_map, std::map<K, V>, is_const, allow_insert, allow_remove>(label, value, settings, response);
+		Detail::map_input<std_map, std::map<K, V, Compare, Alloc>, is_const, allow_insert, allow_remove>(label, value, settings, response);
 	}
 
-	template<typename K, typename V>
-	void tag_invoke(Detail::ImInputLib_t, const char* label, const std::map<K, V>& value, ImSettings& settings, ImResponse& response) {
+	template<typename K, typename V, typename Compare, typename Alloc>
+	void tag_invoke(Detail::ImInputLib_t, const char* label, const std::map<K, V, Compare, Alloc>& value, ImSettings& settings, ImResponse& response) {
 		constexpr bool is_const = true;
 		constexpr bool allow_insert = false;
 		constexpr bool allow_remove = false;
 
-		Detail::map_input<std_map, std::map<K, V>, is_const, allow_insert, allow_remove>(label, value, settings, response);
+		Detail::map_input<std_map, std::map<K, V, Compare, Alloc>, is_const, allow_insert, allow_remove>(label, value, settings, response);
 	}
 
 	/* ========================= std::unordered_map ========================= */
@@ -1602,20 +2782,20 @@ namespace ImReflect {
 		ImReflect::Detail::removable_mixin<std_unordered_map> {
 	};
 
-	template<typename K, typename V>
-	void tag_invoke(Detail::ImInputLib_t, const char* label, std::unordered_map<K, V>& value, ImSettings& settings, ImResponse& response) {
+	template<typename K, typename V, typename Hash, typename KeyEqual, typename Alloc>
+	void tag_invoke(Detail::ImInputLib_t, const char* label, std::unordered_map<K, V, Hash, KeyEqual, Alloc>& value, ImSettings& settings, ImResponse& response) {
 		constexpr bool is_const = false;
 		constexpr bool allow_insert = true;
 		constexpr bool allow_remove = true;
-		Detail::map_input<std_unordered_map, std::unordered_map<K, V>, is_const, allow_insert, allow_remove>(label, value, settings, response);
+		Detail::map_input<std_unordered_map, std::unordered_map<K, V, Hash, KeyEqual, Alloc>, is_const, allow_insert, allow_remove>(label, value, settings, response);
 	}
 
-	template<typename K, typename V>
-	void tag_invoke(Detail::ImInputLib_t, const char* label, const std::unordered_map<K, V>& value, ImSettings& settings, ImResponse& response) {
+	template<typename K, typename V, typename Hash, typename KeyEqual, typename Alloc>
+	void tag_invoke(Detail::ImInputLib_t, const char* label, const std::unordered_map<K, V, Hash, KeyEqual, Alloc>& value, ImSettings& settings, ImResponse& response) {
 		constexpr bool is_const = true;
 		constexpr bool allow_insert = false;
 		constexpr bool allow_remove = false;
-		Detail::map_input<std_unordered_map, std::unordered_map<K, V>, is_const, allow_insert, allow_remove>(label, value, settings, response);
+		Detail::map_input<std_unordered_map, std::unordered_map<K, V, Hash, KeyEqual, Alloc>, is_const, allow_insert, allow_remove>(label, value, settings, response);
 	}
 
 	/* ========================= std::multimap ========================= */
@@ -1628,20 +2808,20 @@ namespace ImReflect {
 		ImReflect::Detail::removable_mixin<std_multimap> {
 	};
 
-	template<typename K, typename V>
-	void tag_invoke(Detail::ImInputLib_t, const char* label, std::multimap<K, V>& value, ImSettings& settings, ImResponse& response) {
+	template<typename K, typename V, typename Compare, typename Alloc>
+	void tag_invoke(Detail::ImInputLib_t, const char* label, std::multimap<K, V, Compare, Alloc>& value, ImSettings& settings, ImResponse& response) {
 		constexpr bool is_const = false;
 		constexpr bool allow_insert = true;
 		constexpr bool allow_remove = true;
-		Detail::map_input<std_multimap, std::multimap<K, V>, is_const, allow_insert, allow_remove>(label, value, settings, response);
+		Detail::map_input<std_multimap, std::multimap<K, V, Compare, Alloc>, is_const, allow_insert, allow_remove>(label, value, settings, response);
 	}
 
-	template<typename K, typename V>
-	void tag_invoke(Detail::ImInputLib_t, const char* label, const std::multimap<K, V>& value, ImSettings& settings, ImResponse& response) {
+	template<typename K, typename V, typename Compare, typename Alloc>
+	void tag_invoke(Detail::ImInputLib_t, const char* label, const std::multimap<K, V, Compare, Alloc>& value, ImSettings& settings, ImResponse& response) {
 		constexpr bool is_const = true;
 		constexpr bool allow_insert = false;
 		constexpr bool allow_remove = false;
-		Detail::map_input<std_multimap, std::multimap<K, V>, is_const, allow_insert, allow_remove>(label, value, settings, response);
+		Detail::map_input<std_multimap, std::multimap<K, V, Compare, Alloc>, is_const, allow_insert, allow_remove>(label, value, settings, response);
 	}
 
 	/* ========================= std::unordered_multimap ========================= */
@@ -1654,20 +2834,20 @@ namespace ImReflect {
 		ImReflect::Detail::removable_mixin<std_unordered_multimap> {
 	};
 
-	template<typename K, typename V>
-	void tag_invoke(Detail::ImInputLib_t, const char* label, std::unordered_multimap<K, V>& value, ImSettings& settings, ImResponse& response) {
+	template<typename K, typename V, typename Hash, typename KeyEqual, typename Alloc>
+	void tag_invoke(Detail::ImInputLib_t, const char* label, std::unordered_multimap<K, V, Hash, KeyEqual, Alloc>& value, ImSettings& settings, ImResponse& response) {
 		constexpr bool is_const = false;
 		constexpr bool allow_insert = true;
 		constexpr bool allow_remove = true;
-		Detail::map_input<std_unordered_multimap, std::unordered_multimap<K, V>, is_const, allow_insert, allow_remove>(label, value, settings, response);
+		Detail::map_input<std_unordered_multimap, std::unordered_multimap<K, V, Hash, KeyEqual, Alloc>, is_const, allow_insert, allow_remove>(label, value, settings, response);
 	}
 
-	template<typename K, typename V>
-	void tag_invoke(Detail::ImInputLib_t, const char* label, const std::unordered_multimap<K, V>& value, ImSettings& settings, ImResponse& response) {
+	template<typename K, typename V, typename Hash, typename KeyEqual, typename Alloc>
+	void tag_invoke(Detail::ImInputLib_t, const char* label, const std::unordered_multimap<K, V, Hash, KeyEqual, Alloc>& value, ImSettings& settings, ImResponse& response) {
 		constexpr bool is_const = true;
 		constexpr bool allow_insert = false;
 		constexpr bool allow_remove = false;
-		Detail::map_input<std_unordered_multimap, std::unordered_multimap<K, V>, is_const, allow_insert, allow_remove>(label, value, settings, response);
+		Detail::map_input<std_unordered_multimap, std::unordered_multimap<K, V, Hash, KeyEqual, Alloc>, is_const, allow_insert, allow_remove>(label, value, settings, response);
 	}
 
 	/* ========================= std::optional ========================= */
@@ -1687,11 +2867,13 @@ namespace ImReflect {
 		ImGui::SameLine();
 
 		const bool was_engaged = value.has_value();
+		Detail::scope_replace<std::optional<T>> replace(label, value);
 
 		bool engaged = was_engaged;
 		ImGui::Checkbox("##optional_engaged", &engaged);
 		Detail::imgui_tooltip("Toggle whether the optional has a value");
 		ImGui::SameLine();
+		if (engaged != was_engaged) replace.capture();
 		if (engaged) {
 			if (!was_engaged) {
 				value = T{};
@@ -1724,6 +2906,7 @@ namespace ImReflect {
 
 		constexpr size_t type_count = sizeof...(Types);
 		const int current_type = static_cast<int>(value.index());
+		Detail::scope_replace<std::variant<Types...>> replace(label, value);
 
 		static const char* type_names[] = { typeid(Types).name()... };
 
@@ -1747,6 +2930,7 @@ namespace ImReflect {
 								Detail::imgui_tooltip("Type is not default constructible, cannot change type");
 								return;
 							} else {
+								replace.capture();
 								value.template emplace<Types>();
 							}
 							var_response.changed();
@@ -1775,9 +2959,22 @@ namespace ImReflect {
 	/* ========================= std::function ========================= */
 	struct std_function {};
 
+	namespace Detail {
+		template<typename T>
+		struct async_mixin {
+		private:
+			bool _async = false;
+		public:
+			/* Run the target on a worker thread instead of inside the frame */
+			type_settings<T>& async(const bool v = true) { _async = v; RETURN_THIS; }
+			const bool& is_async() const { return _async; };
+		};
+	}
+
 	template<>
 	struct type_settings<std_function> : ImRequired<std_function>,
-		ImReflect::Detail::resettable_mixin<std_function> {
+		ImReflect::Detail::resettable_mixin<std_function>,
+		ImReflect::Detail::async_mixin<std_function> {
 	};
 
 	template<>
@@ -1797,6 +2994,56 @@ namespace ImReflect {
 		struct FnReturnStore<Ret, true> {
 			bool has_value = false;
 		};
+
+		/* Arguments being edited in the call popup */
+		template<typename... Args>
+		struct FnArgsStore {
+			std::tuple<Args...> args{};
+		};
+
+		template<typename Ret>
+		struct async_job : async_call {
+			std::optional<Ret> result;
+		};
+
+		template<>
+		struct async_job<void> : async_call {};
+
+		template<typename Ret, typename F>
+		void run_async(async_job<Ret>& job, F&& call) {
+			current_async_call = &job;
+			try {
+				if constexpr (std::is_void_v<Ret>) call();
+				else job.result.emplace(call());
+			} catch (const std::exception& e) {
+				job.error = e.what();
+			} catch (...) {
+				job.error = "unknown exception";
+			}
+			current_async_call = nullptr;
+			job.done.store(true, std::memory_order_release);
+		}
+
+		/* Widget side of an async call */
+		template<typename Ret>
+		struct FnAsyncStore {
+			std::shared_ptr<async_job<Ret>> job;
+			std::string error; /* of the last finished call */
+		};
+	}
+
+	/* For targets of async std::function widgets: true once the user pressed cancel, or the program is exiting */
+	inline bool async_cancelled() {
+		const Detail::async_call* call = Detail::current_async_call;
+		if (!call) return false;
+		return call->cancelled.load(std::memory_order_relaxed) || Detail::async_pool::instance().is_stopping();
+	}
+
+	/* For targets of async std::function widgets: fraction done in [0, 1], replaces the spinner with a progress bar */
+	inline void async_progress(float fraction) {
+		if (Detail::async_call* call = Detail::current_async_call) {
+			call->progress.store(std::clamp(fraction, 0.0f, 1.0f), std::memory_order_relaxed);
+		}
 	}
 
 	template<typename Ret, typename... Args>
@@ -1811,16 +3058,77 @@ namespace ImReflect {
 
 		const std::string final_label = std::string(label) + (has_args ? "()..." : "()");
 
-		/* Per-instantiation statics — same pattern as static T temp_value{} in vector */
-		static std::tuple<std::decay_t<Args>...> s_temp_args{};
-		static Detail::FnReturnStore<Ret> s_return{};
+		/* Per-widget state in the widget store: the last return value lives as long as the widget is drawn,
+		   the arguments as long as the popup is open */
+		using return_store = Detail::FnReturnStore<Ret>;
+		using args_store = Detail::FnArgsStore<std::decay_t<Args>...>;
+		using async_result = std::conditional_t<return_is_displayable, Ret, void>;
+		using async_store = Detail::FnAsyncStore<async_result>;
+		auto& store = Detail::widget_store::current();
 
 		const bool has_target = static_cast<bool>(value);
 
 		/* --- Call button --- */
 		const auto call_popup_id = ImGui::GetID("fn_call_popup");
+		const auto return_id = ImGui::GetID("fn_return");
+		const auto async_id = ImGui::GetID("fn_async");
+
+		/* Call the target, on the worker pool when async. Async calls take the arguments. */
+		const auto invoke = [&](auto& args) {
+			if (fn_settings.is_async()) {
+				auto job = std::make_shared<Detail::async_job<async_result>>();
+				auto moved_args = std::make_shared<std::decay_t<decltype(args)>>(std::move(args));
+				Detail::async_pool::instance().submit([job, target = value, moved_args]() {
+					Detail::run_async(*job, [&]() -> decltype(auto) { return std::apply(target, *moved_args); });
+					});
+				async_store& pending = store.get<async_store>(async_id);
+				pending.job = std::move(job);
+				pending.error.clear();
+			} else if constexpr (return_is_displayable) {
+				return_store& result = store.get<return_store>(return_id);
+				result.value = std::apply(value, args);
+				result.has_value = true;
+			} else {
+				std::apply(value, args);
+			}
+			fn_response.changed();
+			};
 
-		if (!has_target) {
+		/* Collect a finished async call, results of cancelled calls are dropped */
+		async_store* pending = store.find<async_store>(async_id);
+		if (pending && pending->job && pending->job->done.load(std::memory_order_acquire)) {
+			auto& job = *pending->job;
+			if (!job.cancelled.load(std::memory_order_relaxed)) {
+				pending->error = job.error;
+				if constexpr (return_is_displayable) {
+					if (job.result) {
+						return_store& result = store.get<return_store>(return_id);
+						result.value = std::move(*job.result);
+						result.has_value = true;
+					}
+				}
+			}
+			pending->job.reset();
+		}
+
+		if (pending && pending->job) {
+			/* Running: spinner or progress bar, and a cancel button */
+			Detail::async_call& job = *pending->job;
+			ImGui::BeginDisabled();
+			ImGui::Button(final_label.c_str());
+			ImGui::EndDisabled();
+			ImGui::SameLine();
+			const float progress = job.progress.load(std::memory_order_relaxed);
+			if (job.cancelled.load(std::memory_order_relaxed)) {
+				ImGui::TextDisabled("Cancelling...");
+			} else {
+				if (progress >= 0.0f) ImGui::ProgressBar(progress, ImVec2(ImGui::GetFontSize() * 8.0f, 0.0f));
+				else ImGui::Text("%c", "|/-\\"[static_cast<int>(ImGui::GetTime() * 8.0) & 3]);
+				ImGui::SameLine();
+				if (ImGui::SmallButton("Cancel")) job.cancelled.store(true, std::memory_order_relaxed);
+				Detail::imgui_tooltip("Ask the call to stop, the target has to check ImReflect::async_cancelled()");
+			}
+		} else if (!has_target) {
 			ImGui::BeginDisabled();
 			ImGui::Button(final_label.c_str());
 			ImGui::EndDisabled();
@@ -1828,13 +3136,8 @@ namespace ImReflect {
 		} else if constexpr (!has_args) {
 			/* Zero args — call immediately, no popup needed */
 			if (ImGui::Button(final_label.c_str())) {
-				if constexpr (is_void_return) {
-					value();
-				} else if constexpr (return_is_displayable) {
-					s_return.value = value();
-					s_return.has_value = true;
-				}
-				fn_response.changed();
+				std::tuple<> no_args;
+				invoke(no_args);
 			}
 		} else if constexpr (all_default_ctor) {
 			if (ImGui::Button(final_label.c_str())) {
@@ -1848,14 +3151,21 @@ namespace ImReflect {
 			Detail::imgui_tooltip("Cannot call: one or more argument types are not default constructible");
 		}
 
+		if (pending && !pending->error.empty()) {
+			ImGui::SameLine();
+			ImGui::TextColored(ImVec4(1.0f, 0.4f, 0.4f, 1.0f), "failed");
+			Detail::imgui_tooltip(pending->error.c_str());
+		}
+
 		/* --- Inline return value display (zero-arg case only) --- */
 		if constexpr (return_is_displayable) {
-			if (s_return.has_value) {
+			if (return_store* result = store.find<return_store>(return_id); result && result->has_value) {
 				ImGui::SameLine();
 				ImGui::Text("=>");
 				ImGui::SameLine();
 				ImGui::BeginDisabled();
-				ImReflect::Input("##fn_return_inline", s_return.value, fn_settings, fn_response);
+				const Detail::scope_suspend_journal suspend;
+				ImReflect::Input("##fn_return_inline", result->value, fn_settings, fn_response);
 				ImGui::EndDisabled();
 			}
 		}
@@ -1863,14 +3173,16 @@ namespace ImReflect {
 		/* --- Argument popup (same structure as vector add_item_popup) --- */
 		if constexpr (has_args && all_default_ctor) {
 			if (ImGui::BeginPopupEx(call_popup_id, ImGuiWindowFlags_AlwaysAutoResize | ImGuiWindowFlags_NoTitleBar | ImGuiWindowFlags_NoSavedSettings)) {
+				auto& s_temp_args = store.get<args_store>(call_popup_id).args;
+				const Detail::scope_suspend_journal suspend; /* arguments and the last return value live in the widget store */
 
 				/* Return value from last call */
 				if constexpr (return_is_displayable) {
-					if (s_return.has_value) {
+					if (return_store* result = store.find<return_store>(return_id); result && result->has_value) {
 						ImGui::Text("Last return:");
 						ImGui::SameLine();
 						ImGui::BeginDisabled();
-						ImReflect::Input("##fn_return_popup", s_return.value, fn_settings, fn_response);
+						ImReflect::Input("##fn_return_popup", result->value, fn_settings, fn_response);
 						ImGui::EndDisabled();
 						ImGui::Separator();
 					}
@@ -1893,13 +3205,7 @@ namespace ImReflect {
 
 				/* Call */
 				if (ImGui::MenuItem("Call")) {
-					if constexpr (is_void_return) {
-						std::apply(value, s_temp_args);
-					} else if constexpr (return_is_displayable) {
-						s_return.value = std::apply(value, s_temp_args);
-						s_return.has_value = true;
-					}
-					fn_response.changed();
+					invoke(s_temp_args);
 					s_temp_args = {};           /* reset args, same as temp_value = T{} in vector */
 					ImGui::CloseCurrentPopup();
 				}
@@ -1924,6 +3230,95 @@ namespace ImReflect {
 			Detail::imgui_tooltip("Clear the stored callable");
 		}
 	}
+
+	/* ========================= std::atomic ========================= */
+	struct std_atomic {};
+
+	namespace Detail {
+		template<typename T>
+		struct memory_order_mixin {
+		private:
+			std::memory_order _load_order = std::memory_order_seq_cst;
+			std::memory_order _store_order = std::memory_order_seq_cst;
+			bool _compare_exchange = false;
+		public:
+			/* relaxed, acquire or seq_cst */
+			type_settings<T>& load_order(const std::memory_order v) { _load_order = v; RETURN_THIS; }
+			/* relaxed, release or seq_cst */
+			type_settings<T>& store_order(const std::memory_order v) { _store_order = v; RETURN_THIS; }
+			/*
+			* Write edits with a compare-exchange loop instead of a plain store. Numbers get the edited
+			* difference added to whatever the value is by then, so increments from other threads are kept;
+			* floating point values are set exactly when they still hold the value that was shown.
+			* Other types are only replaced when they still hold the value that was shown.
+			*/
+			type_settings<T>& compare_exchange(const bool v = true) { _compare_exchange = v; RETURN_THIS; }
+			const std::memory_order& get_load_order() const { return _load_order; }
+			const std::memory_order& get_store_order() const { return _store_order; }
+			const bool& is_compare_exchange() const { return _compare_exchange; }
+		};
+
+		template<typename T, typename Settings>
+		void atomic_write(std::atomic<T>& value, const T& shown, const T& edited, const Settings& settings) {
+			const std::memory_order order = settings.get_store_order();
+			if (!settings.is_compare_exchange()) {
+				value.store(edited, order);
+			} else if constexpr (std::is_integral_v<T> && !std::is_same_v<T, bool>) {
+				/* Wrapping unsigned math, signed overflow would be undefined */
+				using W = std::make_unsigned_t<T>;
+				const W delta = static_cast<W>(static_cast<W>(edited) - static_cast<W>(shown));
+				T expected = value.load(std::memory_order_relaxed);
+				while (!value.compare_exchange_weak(expected, static_cast<T>(static_cast<W>(static_cast<W>(expected) + delta)), order, std::memory_order_relaxed)) {}
+			} else if constexpr (std::is_floating_point_v<T>) {
+				/* Exactly the edited value while nobody wrote in between, rounding only applies to a fresh value */
+				T expected = shown;
+				if (value.compare_exchange_strong(expected, edited, order, std::memory_order_relaxed)) return;
+				const long double delta = static_cast<long double>(edited) - static_cast<long double>(shown);
+				if (!std::isfinite(delta)) {
+					value.store(edited, order);
+					return;
+				}
+				while (!value.compare_exchange_weak(expected, static_cast<T>(static_cast<long double>(expected) + delta), order, std::memory_order_relaxed)) {}
+			} else {
+				T expected = shown;
+				value.compare_exchange_strong(expected, edited, order, std::memory_order_relaxed);
+			}
+		}
+	}
+
+	template<>
+	struct type_settings<std_atomic> : ImRequired<std_atomic>,
+		ImReflect::Detail::memory_order_mixin<std_atomic> {
+	};
+
+	/* Draws a loaded copy with the widget of T, edits are written back atomically. No locks, no undo/record. */
+	template<typename T>
+	void tag_invoke(Detail::ImInputLib_t, const char* label, std::atomic<T>& value, ImSettings& settings, ImResponse& response) {
+		auto& atomic_settings = settings.get<std_atomic>();
+		auto& atomic_response = response.get<std_atomic>();
+
+		const T shown = value.load(atomic_settings.get_load_order());
+		T edited = shown;
+
+		const std::size_t change_count = atomic_response.change_count();
+		{
+			const Detail::scope_suspend_journal suspend;
+			ImReflect::Input(label, edited, atomic_settings, atomic_response);
+		}
+
+		if (atomic_response.change_count() != change_count) {
+			Detail::atomic_write(value, shown, edited, atomic_settings);
+		}
+	}
+
+	template<typename T>
+	void tag_invoke(Detail::ImInputLib_t, const char* label, const std::atomic<T>& value, ImSettings& settings, ImResponse& response) {
+		auto& atomic_settings = settings.get<std_atomic>();
+		auto& atomic_response = response.get<std_atomic>();
+
+		const T shown = value.load(atomic_settings.get_load_order());
+		ImReflect::Input(label, shown, atomic_settings, atomic_response);
+	}
 }
 
 /* ========================= Category registration ========================= */
@@ -1956,6 +3351,18 @@ template<typename T, typename Alloc>
 struct svh::category<std::vector<T, Alloc>> { using type = ImReflect::std_vector; };
 template<typename T, std::size_t N>
 struct svh::category<std::array<T, N>> { using type = ImReflect::std_array; };
+template<typename T>
+struct svh::category<ImReflect::array_view<T>> { using type = ImReflect::std_span; };
+template<typename T, std::size_t N>
+struct svh::category<T[N]> { using type = ImReflect::std_span; };
+template<std::size_t N>
+struct svh::category<char[N]> { using type = ImReflect::char_buffer; };
+template<std::size_t N>
+struct svh::category<std::array<char, N>> { using type = ImReflect::char_buffer; };
+#if __cplusplus >= 202002L || (defined(_MSVC_LANG) && _MSVC_LANG >= 202002L)
+template<typename T, std::size_t Extent>
+struct svh::category<std::span<T, Extent>> { using type = ImReflect::std_span; };
+#endif
 template<typename T, typename Alloc>
 struct svh::category<std::list<T, Alloc>> { using type = ImReflect::std_list; };
 template<typename T, typename Alloc>
@@ -1981,4 +3388,8 @@ struct svh::category<std::unordered_multimap<Key, T, Hash, KeyEqual, Alloc>> { u
 template<typename T>
 struct svh::category<std::optional<T>> { using type = ImReflect::std_optional; };
 template<typename... Types>
-struct svh::category<std::variant<Types...>> { using type = ImReflect::std_variant; };
\ No newline at end of file
+struct svh::category<std::variant<Types...>> { using type = ImReflect::std_variant; };
+template<typename Signature>
+struct svh::category<std::function<Signature>> { using type = ImReflect::std_function; };
+template<typename T>
+struct svh::category<std::atomic<T>> { using type = ImReflect::std_atomic; };
\ No newline at end of file
@@ -0,0 +1,402 @@
+#pragma once
+#include <extern/visit_struct/visit_struct.hpp>
+#include <extern/magic_enum/magic_enum.hpp>
+
+#include "ImReflect_macro.hpp"
+
+#include <array>
+#include <charconv>
+#include <cstring>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <optional>
+#include <set>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <variant>
+#include <vector>
+
+/* Type categories shared by every traversal that is not a widget (search, diff, serialization) */
+namespace ImReflect::Detail {
+
+	/* Reflected with IMGUI_REFLECT */
+	template<typename T>
+	constexpr bool is_reflected_v = visit_struct::traits::is_visitable<std::remove_cv_t<T>, ImContext>::value;
+
+	/* std::basic_string, with any traits/allocator */
+	template<typename T>
+	struct is_basic_string_impl : std::false_type {};
+	template<typename C, typename Traits, typename Alloc>
+	struct is_basic_string_impl<std::basic_string<C, Traits, Alloc>> : std::true_type {};
+
+	template<typename T>
+	constexpr bool is_basic_string_v = is_basic_string_impl<std::remove_cv_t<T>>::value;
+
+	/* std::string and std::pmr::string, any allocator */
+	template<typename T>
+	struct is_char_string_impl : std::false_type {};
+	template<typename Traits, typename Alloc>
+	struct is_char_string_impl<std::basic_string<char, Traits, Alloc>> : std::true_type {};
+
+	template<typename T>
+	constexpr bool is_char_string_v = is_char_string_impl<std::remove_cv_t<T>>::value;
+
+	/* Is Smart pointers */
+	template<typename T>
+	struct is_smart_pointer_impl : std::false_type {};
+	template<typename T>
+	struct is_smart_pointer_impl<std::shared_ptr<T>> : std::true_type {};
+	template<typename T>
+	struct is_smart_pointer_impl<std::unique_ptr<T>> : std::true_type {};
+	template<typename T>
+	struct is_smart_pointer_impl<std::weak_ptr<T>> : std::true_type {};
+
+	template<typename T>
+	constexpr bool is_smart_pointer_v = Detail::is_smart_pointer_impl<std::remove_cv_t<T>>::value;
+
+	template<typename T>
+	using enable_if_smart_pointer_t = std::enable_if_t<is_smart_pointer_v<T>, void>;
+
+	/* std::optional */
+	template<typename T>
+	struct is_optional_impl : std::false_type {};
+	template<typename T>
+	struct is_optional_impl<std::optional<T>> : std::true_type {};
+
+	template<typename T>
+	constexpr bool is_optional_v = is_optional_impl<std::remove_cv_t<T>>::value;
+
+	/* std::variant */
+	template<typename T>
+	struct is_variant_impl : std::false_type {};
+	template<typename... Ts>
+	struct is_variant_impl<std::variant<Ts...>> : std::true_type {};
+
+	template<typename T>
+	constexpr bool is_variant_v = is_variant_impl<std::remove_cv_t<T>>::value;
+
+	/* std::pair and std::tuple */
+	template<typename T>
+	struct is_tuple_like_impl : std::false_type {};
+	template<typename T1, typename T2>
+	struct is_tuple_like_impl<std::pair<T1, T2>> : std::true_type {};
+	template<typename... Ts>
+	struct is_tuple_like_impl<std::tuple<Ts...>> : std::true_type {};
+
+	template<typename T>
+	constexpr bool is_tuple_like_v = is_tuple_like_impl<std::remove_cv_t<T>>::value;
+
+	/* C arrays, T[N] */
+	template<typename T>
+	struct is_c_array_impl : std::false_type {};
+	template<typename V, std::size_t N>
+	struct is_c_array_impl<V[N]> : std::true_type {};
+
+	template<typename T>
+	constexpr bool is_c_array_v = is_c_array_impl<std::remove_cv_t<T>>::value;
+
+	/* char[N] and std::array<char, N>, null terminated text in a fixed buffer */
+	template<typename T>
+	struct is_char_buffer_impl : std::false_type {};
+	template<std::size_t N>
+	struct is_char_buffer_impl<char[N]> : std::true_type {};
+	template<std::size_t N>
+	struct is_char_buffer_impl<std::array<char, N>> : std::true_type {};
+
+	template<typename T>
+	constexpr bool is_char_buffer_v = is_char_buffer_impl<std::remove_cv_t<T>>::value;
+
+	/* Text of a char buffer, up to the first null or the whole buffer when there is none */
+	template<typename Buffer>
+	std::string_view char_buffer_text(const Buffer& buffer) {
+		const char* data = std::data(buffer);
+		const std::size_t capacity = std::size(buffer);
+		const void* null = std::memchr(data, '\0', capacity);
+		return { data, null ? static_cast<std::size_t>(static_cast<const char*>(null) - data) : capacity };
+	}
+
+	/* Anything iterable with a value_type, strings excluded. C arrays count, their value_type is the element */
+	template<typename T, typename = void>
+	struct is_range_impl : std::false_type {};
+	template<typename T>
+	struct is_range_impl<T, std::void_t<
+		typename T::value_type,
+		decltype(std::begin(std::declval<T&>())),
+		decltype(std::end(std::declval<T&>()))>> : std::true_type {};
+	template<typename V, std::size_t N>
+	struct is_range_impl<V[N], void> : std::true_type {};
+
+	template<typename T>
+	constexpr bool is_range_v = is_range_impl<std::remove_cv_t<T>>::value && !is_basic_string_v<T>;
+
+	/* Element type of a range, ``typename T::value_type`` that also works for T[N] */
+	template<typename T>
+	struct range_value_impl { using type = typename T::value_type; };
+	template<typename V, std::size_t N>
+	struct range_value_impl<V[N]> { using type = V; };
+
+	template<typename T>
+	using range_value_t = typename range_value_impl<std::remove_cv_t<T>>::type;
+
+	/* Ranges of key/value pairs: map, multimap, unordered_map, unordered_multimap */
+	template<typename T, typename = void>
+	struct is_map_like_impl : std::false_type {};
+	template<typename T>
+	struct is_map_like_impl<T, std::void_t<typename T::key_type, typename T::mapped_type>> : std::true_type {};
+
+	template<typename T>
+	constexpr bool is_map_like_v = is_range_v<T> && is_map_like_impl<std::remove_cv_t<T>>::value;
+
+	/* Ranges with a key_type that are not maps: set, multiset, unordered_set, unordered_multiset */
+	template<typename T, typename = void>
+	struct has_key_type_impl : std::false_type {};
+	template<typename T>
+	struct has_key_type_impl<T, std::void_t<typename T::key_type>> : std::true_type {};
+
+	template<typename T>
+	constexpr bool is_set_like_v = is_range_v<T> && has_key_type_impl<std::remove_cv_t<T>>::value && !is_map_like_v<T>;
+
+	/* multimap, multiset and their unordered versions */
+	template<typename T>
+	struct allows_duplicate_keys_impl : std::false_type {};
+	template<typename K, typename V, typename C, typename A>
+	struct allows_duplicate_keys_impl<std::multimap<K, V, C, A>> : std::true_type {};
+	template<typename K, typename V, typename H, typename E, typename A>
+	struct allows_duplicate_keys_impl<std::unordered_multimap<K, V, H, E, A>> : std::true_type {};
+	template<typename K, typename C, typename A>
+	struct allows_duplicate_keys_impl<std::multiset<K, C, A>> : std::true_type {};
+	template<typename K, typename H, typename E, typename A>
+	struct allows_duplicate_keys_impl<std::unordered_multiset<K, H, E, A>> : std::true_type {};
+
+	template<typename T>
+	constexpr bool allows_duplicate_keys_v = allows_duplicate_keys_impl<std::remove_cv_t<T>>::value;
+
+	/* std::array, fixed size */
+	template<typename T>
+	struct is_std_array_impl : std::false_type {};
+	template<typename V, std::size_t N>
+	struct is_std_array_impl<std::array<V, N>> : std::true_type {};
+
+	template<typename T>
+	constexpr bool is_std_array_v = is_std_array_impl<std::remove_cv_t<T>>::value;
+
+	/* std::vector with any allocator, std::pmr::vector included */
+	template<typename T>
+	struct is_std_vector_impl : std::false_type {};
+	template<typename V, typename A>
+	struct is_std_vector_impl<std::vector<V, A>> : std::true_type {};
+
+	template<typename T>
+	constexpr bool is_std_vector_v = is_std_vector_impl<std::remove_cv_t<T>>::value;
+
+	/* Ranges with a fixed element count that are filled in place: std::array, T[N], std::span, ImReflect::array_view */
+	template<typename T, typename = void>
+	struct has_clear_impl : std::false_type {};
+	template<typename T>
+	struct has_clear_impl<T, std::void_t<decltype(std::declval<T&>().clear())>> : std::true_type {};
+
+	template<typename T>
+	constexpr bool is_fixed_range_v = is_range_v<T> && !has_clear_impl<std::remove_cv_t<T>>::value;
+
+	/* Sequences that can be appended to: vector, deque, list */
+	template<typename T, typename = void>
+	struct has_emplace_back_impl : std::false_type {};
+	template<typename T>
+	struct has_emplace_back_impl<T, std::void_t<decltype(std::declval<T&>().emplace_back())>> : std::true_type {};
+
+	template<typename T>
+	constexpr bool has_emplace_back_v = has_emplace_back_impl<std::remove_cv_t<T>>::value;
+
+	/* std::forward_list */
+	template<typename T, typename = void>
+	struct has_emplace_after_impl : std::false_type {};
+	template<typename T>
+	struct has_emplace_after_impl<T, std::void_t<decltype(std::declval<T&>().emplace_after(std::declval<T&>().before_begin()))>> : std::true_type {};
+
+	template<typename T>
+	constexpr bool has_emplace_after_v = has_emplace_after_impl<std::remove_cv_t<T>>::value;
+
+	/* Has a size() member, std::forward_list does not */
+	template<typename T, typename = void>
+	struct has_size_impl : std::false_type {};
+	template<typename T>
+	struct has_size_impl<T, std::void_t<decltype(std::declval<const T&>().size())>> : std::true_type {};
+
+	template<typename T>
+	constexpr bool has_size_v = has_size_impl<std::remove_cv_t<T>>::value;
+
+	template<typename Range>
+	std::size_t range_size(const Range& range) {
+		if constexpr (has_size_v<Range>) {
+			return static_cast<std::size_t>(range.size());
+		} else {
+			return static_cast<std::size_t>(std::distance(std::begin(range), std::end(range)));
+		}
+	}
+
+	/*
+	* operator== that can actually be instantiated.
+	* std containers declare operator== for any element type, so look through them.
+	* C arrays decay to pointers for ==, they are compared element by element instead.
+	*/
+	template<typename T, typename = void>
+	struct has_equal_operator_impl : std::false_type {};
+	template<typename T>
+	struct has_equal_operator_impl<T, std::void_t<decltype(std::declval<const T&>() == std::declval<const T&>())>> : std::bool_constant<!std::is_array_v<T>> {};
+
+	template<typename T>
+	constexpr bool is_equality_comparable();
+
+	template<typename Tuple, std::size_t... I>
+	constexpr bool is_tuple_equality_comparable(std::index_sequence<I...>) {
+		return (is_equality_comparable<std::tuple_element_t<I, Tuple>>() && ...);
+	}
+
+	template<typename Variant, std::size_t... I>
+	constexpr bool is_variant_equality_comparable(std::index_sequence<I...>) {
+		return (is_equality_comparable<std::variant_alternative_t<I, Variant>>() && ...);
+	}
+
+	template<typename T>
+	constexpr bool is_equality_comparable() {
+		using U = std::remove_cv_t<T>;
+		if constexpr (is_c_array_v<U>) {
+			return is_equality_comparable<range_value_t<U>>();
+		} else if constexpr (!has_equal_operator_impl<U>::value) {
+			return false;
+		} else if constexpr (is_basic_string_v<U>) {
+			return true;
+		} else if constexpr (is_range_v<U>) {
+			return is_equality_comparable<range_value_t<U>>();
+		} else if constexpr (is_optional_v<U>) {
+			return is_equality_comparable<typename U::value_type>();
+		} else if constexpr (is_tuple_like_v<U>) {
+			return is_tuple_equality_comparable<U>(std::make_index_sequence<std::tuple_size_v<U>>{});
+		} else if constexpr (is_variant_v<U>) {
+			return is_variant_equality_comparable<U>(std::make_index_sequence<std::variant_size_v<U>>{});
+		} else {
+			return true;
+		}
+	}
+
+	template<typename T>
+	constexpr bool is_equality_comparable_v = is_equality_comparable<T>();
+
+	/*
+	* Copy constructible and assignable all the way down.
+	* std containers report copyable even when their elements are not.
+	*/
+	template<typename T>
+	constexpr bool is_deep_copyable();
+
+	template<typename Tuple, std::size_t... I>
+	constexpr bool is_tuple_deep_copyable(std::index_sequence<I...>) {
+		return (is_deep_copyable<std::tuple_element_t<I, Tuple>>() && ...);
+	}
+
+	template<typename Variant, std::size_t... I>
+	constexpr bool is_variant_deep_copyable(std::index_sequence<I...>) {
+		return (is_deep_copyable<std::variant_alternative_t<I, Variant>>() && ...);
+	}
+
+	/* Array members are not assignable on their own, the struct copies them element by element */
+	template<typename T>
+	constexpr bool is_member_deep_copyable() {
+		if constexpr (std::is_array_v<T>) {
+			return is_member_deep_copyable<std::remove_extent_t<T>>();
+		} else {
+			return is_deep_copyable<T>();
+		}
+	}
+
+	template<typename T, std::size_t... I>
+	constexpr bool is_reflected_deep_copyable(std::index_sequence<I...>) {
+		using ctx = visit_struct::context<ImContext>;
+		return (is_member_deep_copyable<ctx::type_at<static_cast<int>(I), T>>() && ...);
+	}
+
+	template<typename T>
+	constexpr bool is_deep_copyable() {
+		/* const members (map keys) only need to be copy constructible */
+		using U = std::remove_cv_t<T>;
+		if constexpr (!std::is_copy_constructible_v<U> || (!std::is_const_v<T> && !std::is_copy_assignable_v<U>)) {
+			return false;
+		} else if constexpr (is_basic_string_v<U>) {
+			return true;
+		} else if constexpr (is_range_v<U>) {
+			/* Containers copy their elements by construction, map value_type is pair<const K, V> */
+			return is_deep_copyable<const typename U::value_type>();
+		} else if constexpr (is_optional_v<U>) {
+			return is_deep_copyable<typename U::value_type>();
+		} else if constexpr (is_tuple_like_v<U>) {
+			return is_tuple_deep_copyable<U>(std::make_index_sequence<std::tuple_size_v<U>>{});
+		} else if constexpr (is_variant_v<U>) {
+			return is_variant_deep_copyable<U>(std::make_index_sequence<std::variant_size_v<U>>{});
+		} else if constexpr (is_reflected_v<U>) {
+			return is_reflected_deep_copyable<U>(std::make_index_sequence<visit_struct::context<ImContext>::field_count<U>()>{});
+		} else {
+			return true;
+		}
+	}
+
+	template<typename T>
+	constexpr bool is_deep_copyable_v = is_deep_copyable<T>();
+
+	/* Values that can be printed as a single line of text */
+	template<typename T>
+	constexpr bool is_text_leaf_v =
+		std::is_arithmetic_v<std::remove_cv_t<T>> ||
+		std::is_enum_v<std::remove_cv_t<T>> ||
+		is_basic_string_v<T> ||
+		is_char_buffer_v<T>;
+
+	/*
+	* Append a short textual representation of a leaf value.
+	* Returns false (and appends nothing) when the type has no textual form.
+	*/
+	template<typename T>
+	bool append_text(std::string& out, const T& value) {
+		using U = std::remove_cv_t<T>;
+		if constexpr (std::is_same_v<U, bool>) {
+			out += value ? "true" : "false";
+			return true;
+		} else if constexpr (std::is_same_v<U, char>) {
+			out += value;
+			return true;
+		} else if constexpr (std::is_integral_v<U>) {
+			/* Widen so every character/integer type hits a to_chars overload */
+			using wide_t = std::conditional_t<std::is_signed_v<U>, long long, unsigned long long>;
+			char buffer[32];
+			const auto result = std::to_chars(buffer, buffer + sizeof(buffer), static_cast<wide_t>(value));
+			out.append(buffer, result.ptr);
+			return true;
+		} else if constexpr (std::is_floating_point_v<U>) {
+			char buffer[64];
+			const auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+			out.append(buffer, result.ptr);
+			return true;
+		} else if constexpr (std::is_enum_v<U>) {
+			const auto name = magic_enum::enum_name(value);
+			if (name.empty()) {
+				return append_text(out, static_cast<std::underlying_type_t<U>>(value));
+			}
+			out.append(name.data(), name.size());
+			return true;
+		} else if constexpr (is_char_string_v<U>) {
+			out.append(value.data(), value.size());
+			return true;
+		} else if constexpr (is_char_buffer_v<U>) {
+			const std::string_view text = char_buffer_text(value);
+			out.append(text.data(), text.size());
+			return true;
+		} else {
+			return false;
+		}
+	}
+}
@@ -0,0 +1,378 @@
+#pragma once
+#include <imgui.h>
+
+#include "ImReflect_entry.hpp"
+#include "ImReflect_helper.hpp"
+#include "ImReflect_record.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/*
+* Undo/redo journal for edits made through ImReflect widgets.
+*
+* Only the edited leaf is stored (before and after bytes), never the whole object.
+* A drag or a typing session is one entry: it starts when the leaf changes or activates
+* and ends when the widget is released.
+* Entries live in a ring buffer, their bytes in a fixed size arena; the oldest entries are
+* dropped when either is full.
+*
+* Entries refer to the edited leaf by its path from the root passed to ``Input``, the same
+* paths ``edit_recorder`` writes: member and element indices, map entries by key. Undo and redo
+* resolve the path again, so containers may reallocate in between.
+* Changes of a container's shape (insert, erase, reorder, bulk operations, paste) are entries
+* of their own holding the whole container, so the paths of the entries around them stay right.
+* A shape change of a container that can't be saved (elements without default constructor)
+* clears the journal. An entry whose path doesn't lead to a value of the recorded type, because
+* the object was changed elsewhere, is skipped. Call ``clear()`` when a root object is destroyed.
+* A value written by undo or redo reports ``changed()`` through its widget the next time it is drawn.
+* Widgets drawn on temporary copies are not recorded, they are not inside the root.
+*
+* Example:
+*	static ImReflect::undo_journal journal;
+*	ImReflect::UndoRedoButtons(journal);
+*	ImReflect::Input("scene", scene, settings, journal);
+*/
+namespace ImReflect {
+
+	class undo_journal : public Detail::edit_journal {
+	public:
+		explicit undo_journal(std::size_t max_entries = 256, std::size_t arena_bytes = 1024 * 1024)
+			: _entries(std::max<std::size_t>(max_entries, 1)), _arena(arena_bytes) {}
+
+		undo_journal(const undo_journal&) = delete;
+		undo_journal& operator=(const undo_journal&) = delete;
+
+		bool can_undo() const { return _cursor > 0; }
+		bool can_redo() const { return _cursor < _count; }
+		std::size_t undo_count() const { return _cursor; }
+		std::size_t redo_count() const { return _count - _cursor; }
+
+		/* Label of the entry ``undo()``/``redo()`` would apply, empty when there is none */
+		std::string_view undo_label() const { return can_undo() ? label_of(at(_cursor - 1)) : std::string_view(); }
+		std::string_view redo_label() const { return can_redo() ? label_of(at(_cursor)) : std::string_view(); }
+
+		/* False when there is nothing to undo or the entry's value is gone, the entry is passed either way */
+		bool undo() {
+			finish_all();
+			if (!can_undo()) return false;
+			const entry& e = at(--_cursor);
+			return load(e, e.before_offset(), e.before_size);
+		}
+
+		bool redo() {
+			finish_all();
+			if (!can_redo()) return false;
+			const entry& e = at(_cursor++);
+			return load(e, e.before_offset() + e.before_size, e.after_size);
+		}
+
+		void clear() {
+			_pending.clear();
+			_first = 0;
+			_count = 0;
+			_cursor = 0;
+			_write = 0;
+		}
+
+		/* Finish edits whose widget was not drawn last frame, done by ``scope_journal`` */
+		void new_frame() {
+			const int frame = ImGui::GetFrameCount();
+			if (_applied_frame < frame - 1) _applied.clear(); /* written values that were not drawn */
+			for (std::size_t i = 0; i < _pending.size();) {
+				if (_pending[i].last_frame < frame - 1) {
+					finish(i);
+				} else {
+					++i;
+				}
+			}
+		}
+
+		void on_leaf(const char* label, void* address, const Detail::journal_codec& codec, const void* before, bool changed, bool active, bool finished) override {
+			const int frame = ImGui::GetFrameCount();
+			std::size_t index = find_pending(address);
+			if (index == npos) {
+				if (!changed && !active) return;
+
+				/* Only leaves inside the root can be found again */
+				pending_edit edit;
+				if (_binding.root == nullptr || !_binding.locate(_binding.root, address, nullptr, edit.path, edit.tag)) return;
+				edit.address = address;
+				edit.root = _binding.root;
+				edit.resolve = _binding.resolve;
+				edit.label = label ? label : "";
+				save(edit.before, before ? before : address, codec);
+				_pending.push_back(std::move(edit));
+				index = _pending.size() - 1;
+			}
+
+			pending_edit& edit = _pending[index];
+			edit.last_frame = frame;
+			if (changed) {
+				edit.edited = true;
+				save(edit.after, address, codec);
+			}
+
+			if (finished || !active) {
+				finish(index);
+			}
+		}
+
+		void on_replace(const char* label, void* address, const void* type, const Detail::journal_codec* codec, const unsigned char* before, std::size_t before_size) override {
+			/* Edits in progress happened first, their addresses may be gone now */
+			finish_all();
+
+			pending_edit edit;
+			if (_binding.root == nullptr || !_binding.locate(_binding.root, address, type, edit.path, edit.tag)) return;
+			if (codec == nullptr) {
+				clear(); /* can't be undone, and older entries below ``address`` may lead elsewhere now */
+				return;
+			}
+			edit.root = _binding.root;
+			edit.resolve = _binding.resolve;
+			edit.label = label ? label : "";
+			edit.before.assign(before, before + before_size);
+			save(edit.after, address, *codec);
+			edit.edited = true;
+			if (edit.before != edit.after) push(edit);
+		}
+
+		bool take_applied(const void* address, const void* type) override {
+			for (std::size_t i = 0; i < _applied.size(); ++i) {
+				if (_applied[i].address == address && _applied[i].type == type) {
+					_applied.erase(_applied.begin() + static_cast<std::ptrdiff_t>(i));
+					return true;
+				}
+			}
+			return false;
+		}
+
+	private:
+		friend struct scope_journal;
+
+		static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+		using locate_fn = bool(*)(void*, const void*, const void*, std::vector<std::uint32_t>&, std::uint32_t&);
+		using resolve_fn = Detail::record_target(*)(void*, const std::uint32_t*, std::size_t, std::uint32_t);
+
+		/* Root of the ``Input`` call being drawn */
+		struct root_binding {
+			void* root = nullptr;
+			locate_fn locate = nullptr;
+			resolve_fn resolve = nullptr;
+		};
+
+		struct entry {
+			void* root = nullptr;
+			resolve_fn resolve = nullptr;
+			std::uint32_t tag = 0;
+			std::size_t offset = 0; /* label, path, before and after bytes, back to back in the arena */
+			std::uint32_t label_size = 0;
+			std::uint32_t path_size = 0; /* steps */
+			std::uint32_t before_size = 0;
+			std::uint32_t after_size = 0;
+
+			std::size_t path_bytes() const { return std::size_t(path_size) * sizeof(std::uint32_t); }
+			std::size_t before_offset() const { return offset + label_size + path_bytes(); }
+			std::size_t payload_size() const { return std::size_t(label_size) + path_bytes() + before_size + after_size; }
+		};
+
+		struct pending_edit {
+			void* address = nullptr; /* stays valid while the widget is drawn */
+			void* root = nullptr;
+			resolve_fn resolve = nullptr;
+			std::vector<std::uint32_t> path;
+			std::uint32_t tag = 0;
+			std::string label;
+			std::vector<unsigned char> before;
+			std::vector<unsigned char> after;
+			int last_frame = 0;
+			bool edited = false;
+		};
+
+		static void save(std::vector<unsigned char>& out, const void* value, const Detail::journal_codec& codec) {
+			out.resize(codec.size(value));
+			if (!out.empty()) codec.save(value, out.data());
+		}
+
+		entry& at(std::size_t i) { return _entries[(_first + i) % _entries.size()]; }
+		const entry& at(std::size_t i) const { return _entries[(_first + i) % _entries.size()]; }
+
+		std::string_view label_of(const entry& e) const {
+			return std::string_view(reinterpret_cast<const char*>(_arena.data() + e.offset), e.label_size);
+		}
+
+		/* Write the bytes at ``at`` into the value the entry's path leads to now */
+		bool load(const entry& e, std::size_t at, std::size_t size) {
+			_steps.resize(e.path_size);
+			if (!_steps.empty()) std::memcpy(_steps.data(), _arena.data() + e.offset + e.label_size, e.path_bytes());
+			const Detail::record_target target = e.resolve(e.root, _steps.data(), _steps.size(), e.tag);
+			if (target.address == nullptr) return false;
+			target.codec->load(target.address, _arena.data() + at, size);
+			_applied.push_back({ target.address, target.type });
+			_applied_frame = ImGui::GetFrameCount();
+			return true;
+		}
+
+		std::size_t find_pending(const void* address) const {
+			for (std::size_t i = 0; i < _pending.size(); ++i) {
+				if (_pending[i].address == address) return i;
+			}
+			return npos;
+		}
+
+		void finish_all() {
+			while (!_pending.empty()) finish(_pending.size() - 1);
+		}
+
+		void finish(std::size_t index) {
+			pending_edit edit = std::move(_pending[index]);
+			_pending.erase(_pending.begin() + static_cast<std::ptrdiff_t>(index));
+			if (!edit.edited || edit.before == edit.after) return;
+			push(edit);
+		}
+
+		void drop_oldest() {
+			_first = (_first + 1) % _entries.size();
+			--_count;
+			if (_cursor > 0) --_cursor;
+		}
+
+		static bool overlaps(const entry& e, std::size_t begin, std::size_t size) {
+			return e.offset < begin + size && begin < e.offset + e.payload_size();
+		}
+
+		void push(const pending_edit& edit) {
+			const std::string_view label = std::string_view(edit.label).substr(0, edit.label.find("##"));
+			const std::size_t path_bytes = edit.path.size() * sizeof(std::uint32_t);
+			const std::size_t size = label.size() + path_bytes + edit.before.size() + edit.after.size();
+			if (size > _arena.size()) return; /* can never fit */
+
+			/* A new edit throws away everything that was undone */
+			_count = _cursor;
+			_write = _count > 0 ? at(_count - 1).offset + at(_count - 1).payload_size() : 0;
+
+			if (_write + size > _arena.size()) {
+				/* Wrap around, whatever sits behind the write position is the oldest data */
+				while (_count > 0 && at(0).offset >= _write) drop_oldest();
+				_write = 0;
+			}
+			while (_count > 0 && (overlaps(at(0), _write, size) || _count == _entries.size())) {
+				drop_oldest();
+			}
+
+			entry& e = at(_count);
+			e.root = edit.root;
+			e.resolve = edit.resolve;
+			e.tag = edit.tag;
+			e.offset = _write;
+			e.label_size = static_cast<std::uint32_t>(label.size());
+			e.path_size = static_cast<std::uint32_t>(edit.path.size());
+			e.before_size = static_cast<std::uint32_t>(edit.before.size());
+			e.after_size = static_cast<std::uint32_t>(edit.after.size());
+
+			unsigned char* out = _arena.data() + _write;
+			if (!label.empty()) std::memcpy(out, label.data(), label.size());
+			out += label.size();
+			if (path_bytes > 0) std::memcpy(out, edit.path.data(), path_bytes);
+			out += path_bytes;
+			if (!edit.before.empty()) std::memcpy(out, edit.before.data(), edit.before.size());
+			out += edit.before.size();
+			if (!edit.after.empty()) std::memcpy(out, edit.after.data(), edit.after.size());
+
+			_write += size;
+			++_count;
+			_cursor = _count;
+		}
+
+		std::vector<entry> _entries;      /* ring buffer */
+		std::vector<unsigned char> _arena; /* ring of entry payloads */
+		std::size_t _first = 0;  /* oldest entry */
+		std::size_t _count = 0;  /* entries in the ring */
+		std::size_t _cursor = 0; /* entries currently applied, the rest can be redone */
+		std::size_t _write = 0;  /* next free byte in the arena */
+
+		std::vector<pending_edit> _pending; /* edits still in progress, usually one */
+		root_binding _binding;
+		std::vector<std::uint32_t> _steps; /* scratch for undo/redo */
+
+		/* Values written by undo/redo, until their widget reports the change */
+		struct applied_value {
+			const void* address;
+			const void* type;
+		};
+		std::vector<applied_value> _applied;
+		int _applied_frame = 0;
+	};
+
+	/* While alive, edits made through ImReflect widgets to leaves inside ``root`` are recorded in ``journal`` */
+	struct scope_journal {
+		undo_journal& journal;
+		Detail::edit_journal* const previous;
+		const undo_journal::root_binding previous_binding;
+
+		template<typename T>
+		scope_journal(undo_journal& journal, T& root) : journal(journal), previous(Detail::active_journal()), previous_binding(journal._binding) {
+			using U = std::remove_const_t<T>;
+			journal.new_frame();
+			journal._binding = { const_cast<U*>(&root), &Detail::locate_leaf<U>, &Detail::resolve_leaf<U> };
+			Detail::active_journal() = &journal;
+		}
+		~scope_journal() {
+			Detail::active_journal() = previous;
+			journal._binding = previous_binding;
+		}
+	};
+
+	/* Record edits made to ``value`` */
+	template<typename T>
+	ImResponse Input(const char* label, T& value, ImSettings& settings, undo_journal& journal) {
+		const scope_journal scope(journal, value);
+		ImResponse response;
+		Detail::InputImpl(label, value, settings, response);
+		return response;
+	}
+
+	template<typename T>
+	ImResponse Input(const char* label, T& value, undo_journal& journal) {
+		ImSettings settings;
+		return Input(label, value, settings, journal);
+	}
+
+	/* Undo/Redo buttons, also handles Ctrl+Z / Ctrl+Y while the window is focused. Returns true when something was applied. */
+	inline bool UndoRedoButtons(undo_journal& journal) {
+		bool applied = false;
+		{
+			const Detail::scope_disabled disabled(!journal.can_undo());
+			if (ImGui::Button("Undo")) applied |= journal.undo();
+		}
+		if (journal.can_undo()) {
+			const std::string tooltip(journal.undo_label());
+			Detail::imgui_tooltip(tooltip.c_str());
+		}
+		ImGui::SameLine();
+		{
+			const Detail::scope_disabled disabled(!journal.can_redo());
+			if (ImGui::Button("Redo")) applied |= journal.redo();
+		}
+		if (journal.can_redo()) {
+			const std::string tooltip(journal.redo_label());
+			Detail::imgui_tooltip(tooltip.c_str());
+		}
+
+		/* Don't steal Ctrl+Z from an active text field, it has its own undo */
+		if (ImGui::IsWindowFocused(ImGuiFocusedFlags_RootAndChildWindows) && !ImGui::IsAnyItemActive()) {
+			const ImGuiIO& io = ImGui::GetIO();
+			if (io.KeyCtrl && ImGui::IsKeyPressed(ImGuiKey_Z, false)) {
+				applied |= io.KeyShift ? journal.redo() : journal.undo();
+			} else if (io.KeyCtrl && ImGui::IsKeyPressed(ImGuiKey_Y, false)) {
+				applied |= journal.redo();
+			}
+		}
+		return applied;
+	}
+}
@@ -4,6 +4,11 @@
 
 #include <ImReflect.hpp>
 
+#include <atomic>
+#include <chrono>
+#include <memory_resource>
+#include <thread>
+
 #define IMGUI_SAMPLE_CODE(x) \
 ImGui::Text(#x); \
 x
@@ -1025,6 +1030,66 @@ if (struct_response.get_member<&MyStruct::a>().is_changed()) {
 		ImGui::PopID();
 	}
 
+	ImGui::NewLine();
+
+	ImGui::Text("Deferred commit");
+	HelpMarker("Edits go to a shadow copy and are written to the value when the widget is released.\nis_changed() and is_committed() are set once per edit instead of every frame of a drag.");
+	{
+		ImGui::PushID("deferred commit");
+		const std::string code = R"(static float my_float = 0.0f;
+auto config = ImSettings();
+config.push<float>()
+	.deferred_commit()
+	.pop();
+ImResponse response = ImReflect::Input("my_float", my_float, config);
+if (response.get<float>().is_committed()) {
+	// expensive rebuild, once per drag
+})";
+		IMGUI_SAMPLE_MULTI_CODE(code);
+		ImGui::Text("Output:");
+		static float my_float = 0.0f;
+		static int commit_count = 0;
+		auto config = ImSettings();
+		config.push<float>()
+			.deferred_commit()
+			.pop();
+		ImResponse response = ImReflect::Input("my_float", my_float, config);
+		if (response.get<float>().is_committed()) ++commit_count;
+		ImGui::Text("value: %.3f", my_float);
+		ImGui::Text("commits: %d", commit_count);
+		ImGui::PopID();
+	}
+
+	ImGui::NewLine();
+
+	ImGui::Text("Change callbacks");
+	HelpMarker("Callbacks registered on the settings are called from the widget, no need to check the response");
+	{
+		ImGui::PushID("change callbacks");
+		const std::string code = R"(static int my_int = 0;
+static ImSettings config;
+if (!config.get<int>().has_callbacks()) {
+	config.push<int>()
+		.on_change([](int& value) { last_value = value; ++change_count; })
+		.pop();
+}
+ImReflect::Input("my_int", my_int, config);)";
+		IMGUI_SAMPLE_MULTI_CODE(code);
+		ImGui::Text("Output:");
+		static int my_int = 0;
+		static int last_value = 0;
+		static int change_count = 0;
+		static ImSettings config;
+		if (!config.get<int>().has_callbacks()) {
+			config.push<int>()
+				.on_change([](int& value) { last_value = value; ++change_count; })
+				.pop();
+		}
+		ImReflect::Input("my_int", my_int, config);
+		ImGui::Text("last value: %d, changes: %d", last_value, change_count);
+		ImGui::PopID();
+	}
+
 	ImGui::Unindent();
 	ImGui::PopID();
 }
@@ -1119,6 +1184,49 @@ config.push<std::string>()
 		ImReflect::Input("my_string##multiline auto resize", my_string, config);
 	}
 
+	ImGui::NewLine();
+
+	ImGui::Text("Fixed capacity buffers");
+	HelpMarker("char[N] and std::array<char, N> are edited in place, nothing is allocated.\nstd::string_view is only displayed.");
+	{
+		static char name[32] = "fixed buffer";
+		static std::array<char, 16> tag = { 'i', 'd', '-', '4', '2' };
+		static const std::string_view view = "viewed, not owned";
+
+		ImSettings config;
+		config.push<ImReflect::char_buffer>()
+			.chars_uppercase()
+			.pop();
+
+		const std::string code = R"(ImSettings config;
+config.push<ImReflect::char_buffer>()
+	.chars_uppercase()
+.pop();)";
+
+		IMGUI_SAMPLE_MULTI_CODE(code);
+		ImGui::Text("Output:");
+		ImReflect::Input("name", name, config);
+		ImReflect::Input("tag", tag, config);
+		ImReflect::Input("view", view);
+
+		/* Saved as JSON strings, read back into buffers full of garbage */
+		const std::string name_json = ImReflect::ToJson(name);
+		const std::string tag_json = ImReflect::ToJson(tag);
+		char name_copy[32];
+		std::array<char, 16> tag_copy;
+		char small[4];
+		std::memset(name_copy, 'x', sizeof(name_copy));
+		tag_copy.fill('x');
+		const bool round_trip =
+			ImReflect::ReadJson(name_json, name_copy) && std::strcmp(name_copy, name) == 0 &&
+			ImReflect::ReadJson(tag_json, tag_copy) && std::strcmp(tag_copy.data(), tag.data()) == 0 &&
+			!ImReflect::ReadJson(R"("too long")", small);
+		ImGui::Text("JSON: %s %s", name_json.c_str(), tag_json.c_str());
+		ImGui::SameLine();
+		if (round_trip) ImGui::TextDisabled("round trip ok");
+		else ImGui::TextColored(ImVec4(1, 0.4f, 0.4f, 1), "round trip differs");
+	}
+
 	ImGui::Unindent();
 	ImGui::PopID();
 }
@@ -1471,6 +1579,18 @@ static void vector_test() {
 		ImGui::PopID();
 	}
 
+	ImGui::Text("Custom allocator");
+	HelpMarker("Containers and strings with any allocator, comparator or hash use the same widgets.\nThese live in a monotonic arena and are edited without copying.");
+	{
+		ImGui::PushID("custom allocator");
+		static std::pmr::monotonic_buffer_resource arena;
+		static std::pmr::vector<std::pmr::string> names({ "alpha", "beta" }, &arena);
+		static std::pmr::map<std::pmr::string, float, std::greater<>> weights({ { "low", 0.25f }, { "high", 0.75f } }, &arena);
+		ImReflect::Input("names", names);
+		ImReflect::Input("weights", weights);
+		ImGui::PopID();
+	}
+
 	ImGui::NewLine();
 
 	ImGui::Text("Vector dropdown");
@@ -1561,6 +1681,101 @@ config.push<std::vector>()
 		ImGui::PopID();
 	}
 
+	ImGui::NewLine();
+
+	ImGui::Text("Vector summary");
+	HelpMarker("Min, max, mean, standard deviation and a histogram above the items.\nLarge containers are summarized on a worker thread, the result is kept until the size or a sampled checksum changes.");
+	{
+		ImGui::PushID("vector summary");
+		static std::vector<float> samples = []() {
+			std::vector<float> values(4000000);
+			std::uint32_t state = 12345;
+			for (float& v : values) {
+				/* Sum of uniforms, roughly normal */
+				float sum = 0.0f;
+				for (int i = 0; i < 4; ++i) {
+					state = state * 1664525u + 1013904223u;
+					sum += float(state >> 8) / float(1 << 24);
+				}
+				v = sum - 2.0f;
+			}
+			return values;
+		}();
+		ImSettings config;
+		config.push<std::vector>()
+			____.as_dropdown()
+			____.summary()
+			____.histogram_bins(48)
+			.pop();
+		IMGUI_SAMPLE_MULTI_CODE(R"(config.push<std::vector>()
+	.as_dropdown()
+	.summary()
+	.histogram_bins(48)
+	.pop();)");
+		static auto budget = ImReflect::frame_budget().max_fields(50);
+		ImReflect::Input("samples", samples, config, budget);
+		ImGui::PopID();
+	}
+
+	ImGui::NewLine();
+
+	ImGui::Text("Vector plot");
+	HelpMarker("Numeric vectors and arrays can be drawn as a plot.\nLong sequences are decimated to a min/max pair per pixel, the result is kept until the data or the width changes.");
+	{
+		ImGui::PushID("vector plot");
+		static std::vector<double> signal = []() {
+			std::vector<double> values(10000000);
+			for (std::size_t i = 0; i < values.size(); ++i) {
+				values[i] = std::sin(double(i) * 0.00001) + ((i % 100000) == 0 ? 2.0 : 0.0);
+			}
+			return values;
+		}();
+		static bool histogram = false;
+		ImGui::Checkbox("histogram", &histogram);
+		ImSettings config;
+		auto& vector_config = config.push<std::vector>();
+		if (histogram) vector_config.as_plot_histogram();
+		else vector_config.as_plot();
+		vector_config.pop();
+		IMGUI_SAMPLE_MULTI_CODE(R"(config.push<std::vector>()
+	.as_plot() // or .as_plot_histogram()
+	.pop();)");
+		ImReflect::Input("signal", signal, config);
+		ImGui::PopID();
+	}
+
+	ImGui::NewLine();
+
+	ImGui::Text("Memory view");
+	HelpMarker("Byte vectors and arrays can be shown as a hex view, only the visible rows are drawn.\nClick a byte to type over it, the search takes hex bytes or text.");
+	{
+		ImGui::PushID("memory view");
+		static std::vector<std::uint8_t> bytes = []() {
+			std::vector<std::uint8_t> values(4 * 1024 * 1024);
+			for (std::size_t i = 0; i < values.size(); ++i) values[i] = static_cast<std::uint8_t>(i * 31 + (i >> 8));
+			const char marker[] = "ImReflect";
+			std::memcpy(values.data() + values.size() / 2, marker, sizeof(marker) - 1);
+			return values;
+		}();
+		static std::array<std::byte, 64> header{};
+		ImSettings config;
+		config.push<std::vector>()
+			.as_memory_view()
+			.bytes_per_row(16)
+			.memory_view_rows(12)
+			.pop();
+		ImSettings config_header;
+		config_header.push<std::array<std::byte, 64>>().as_memory_view().memory_view_rows(4).pop();
+		IMGUI_SAMPLE_MULTI_CODE(R"(config.push<std::vector>()
+	.as_memory_view()
+	.bytes_per_row(16)
+	.memory_view_rows(12)
+	.pop();)");
+		ImReflect::Input("bytes", bytes, config);
+		ImReflect::Input("header", header, config_header);
+		ImGui::PopID();
+	}
+
 	ImGui::Unindent();
 	ImGui::PopID();
 }
@@ -1589,6 +1804,27 @@ static void array_test() {
 		ImReflect::Input("my_array_const", my_array_const);
 		ImGui::PopID();
 	}
+	ImGui::NewLine();
+	ImGui::Text("External memory");
+	HelpMarker("C arrays, std::span and ImReflect::array_view (pointer + size) are edited in place, nothing is copied.\nThey use the same widgets and settings as std::array.");
+	{
+		ImGui::PushID("external memory");
+		static int raw[5] = { 1, 2, 3, 4, 5 };
+		ImReflect::Input("raw", raw);
+
+		static float* pool = new float[6]{ 0.5f, 1.0f, 1.5f, 2.0f, 2.5f, 3.0f };
+		ImReflect::array_view<float> view(pool, 6);
+		ImSettings config;
+		config.push<ImReflect::std_span>()
+			.as_dropdown()
+			.pop();
+		IMGUI_SAMPLE_MULTI_CODE(R"(ImReflect::array_view<float> view(pool, 6);
+config.push<ImReflect::std_span>()
+	.as_dropdown()
+	.pop();)");
+		ImReflect::Input("view", view, config);
+		ImGui::PopID();
+	}
 	ImGui::Unindent();
 	ImGui::PopID();
 }
@@ -2069,6 +2305,92 @@ static void function_test() {
 		ImGui::PopID();
 	}
 
+	ImGui::NewLine();
+
+	ImGui::Text("Async std::function");
+	HelpMarker("With .async() the call runs on a worker thread, the UI keeps running and shows the progress. The target checks ImReflect::async_cancelled() to stop early");
+	{
+		static std::function<long long(int)> slow_sum = [](int steps) {
+			long long sum = 0;
+			for (int i = 0; i < steps && !ImReflect::async_cancelled(); ++i) {
+				sum += i;
+				ImReflect::async_progress(float(i + 1) / float(steps));
+				std::this_thread::sleep_for(std::chrono::milliseconds(20));
+			}
+			return sum;
+		};
+		ImSettings settings;
+		settings.push<std::function<long long(int)>>()
+			.async()
+			.pop();
+		ImGui::PushID("async function");
+		ImReflect::Input("slow_sum", slow_sum, settings);
+		ImGui::PopID();
+	}
+
+
+	ImGui::Unindent();
+	ImGui::PopID();
+}
+
+// ========================================
+// std::atomic
+// ========================================
+struct atomic_counters {
+	std::atomic<int> processed{ 0 };
+	std::atomic<float> load{ 0.0f };
+	std::atomic<bool> paused{ false };
+};
+IMGUI_REFLECT(atomic_counters, processed, load, paused)
+
+/* Updates the counters from its own thread, the UI reads and writes them without a lock */
+struct atomic_worker {
+	atomic_counters counters;
+	std::atomic<bool> running{ true };
+	std::thread thread;
+
+	atomic_worker() {
+		thread = std::thread([this]() {
+			int tick = 0;
+			while (running) {
+				if (!counters.paused.load(std::memory_order_relaxed)) {
+					counters.processed.fetch_add(1, std::memory_order_relaxed);
+					counters.load.store(float(++tick % 100) / 100.0f, std::memory_order_relaxed);
+				}
+				std::this_thread::sleep_for(std::chrono::milliseconds(10));
+			}
+			});
+	}
+	~atomic_worker() {
+		running = false;
+		thread.join();
+	}
+};
+
+static void atomic_test() {
+	ImGui::SeparatorText("std::atomic Test");
+	ImGui::PushID("atomic_test");
+	ImGui::Indent();
+
+	ImGui::Text("Counters updated by a worker thread");
+	HelpMarker("Values are loaded every frame with the configured memory order.\nWith compare_exchange, dragging the counter adds the difference to the current value, the increments of the worker are kept.");
+	IMGUI_SAMPLE_MULTI_CODE(R"(config.push<std::atomic<int>>()
+	.load_order(std::memory_order_relaxed)
+	.compare_exchange()
+	.pop();)");
+
+	static atomic_worker worker;
+	ImSettings config;
+	config.push<std::atomic<int>>()
+		.load_order(std::memory_order_relaxed)
+		.compare_exchange()
+		.pop();
+	config.push<float>()
+		.as_slider()
+		.min(0.0f)
+		.max(1.0f)
+		.pop();
+	ImReflect::Input("counters", worker.counters, config);
 
 	ImGui::Unindent();
 	ImGui::PopID();
@@ -2337,6 +2659,553 @@ static void complex_object_test() {
 	ImGui::PopID();
 }
 
+// ========================================
+// Search
+// ========================================
+struct search_item {
+	std::string name;
+	int count = 0;
+	float weight = 0.0f;
+};
+IMGUI_REFLECT(search_item, name, count, weight)
+
+struct search_inventory {
+	std::string owner = "player";
+	int gold = 250;
+	std::vector<search_item> items;
+	std::map<std::string, int> skills;
+	std::optional<search_item> equipped;
+};
+IMGUI_REFLECT(search_inventory, owner, gold, items, skills, equipped)
+
+static void search_test() {
+	ImGui::SeparatorText("Search");
+	ImGui::PushID("Search");
+	ImGui::Indent();
+
+	ImGui::Text("Filter fields");
+	HelpMarker("Type in the filter box to only show matching fields, their parents and their children.\nThe index is built a few nodes per frame and only rebuilds the subtrees that changed shape.");
+	IMGUI_SAMPLE_MULTI_CODE(R"(static ImReflect::search_index index;
+ImReflect::SearchBox("##filter", index);
+ImReflect::Input("inventory", inventory, index);)");
+
+	static search_inventory inventory = []() {
+		search_inventory result;
+		for (int i = 0; i < 200; ++i) {
+			result.items.push_back({ "item_" + std::to_string(i), i % 7, i * 0.5f });
+		}
+		result.skills = { {"mining", 3}, {"smithing", 5}, {"fishing", 1} };
+		result.equipped = search_item{ "sword", 1, 3.5f };
+		return result;
+		}();
+
+	static ImReflect::search_index index;
+	index.nodes_per_frame(256);
+	ImReflect::SearchBox("##filter", index);
+	ImReflect::Input("inventory", inventory, index);
+
+	ImGui::Unindent();
+	ImGui::PopID();
+}
+
+// ========================================
+// Frame budget
+// ========================================
+static void budget_test() {
+	ImGui::SeparatorText("Frame Budget");
+	ImGui::PushID("Frame Budget");
+	ImGui::Indent();
+
+	ImGui::Text("Budgeted rendering");
+	HelpMarker("Only the first fields are rendered each frame, the rest is replaced by a placeholder.\nLimits can be a field count, a time in microseconds, or both.");
+	IMGUI_SAMPLE_MULTI_CODE(R"(static auto budget = ImReflect::frame_budget().max_fields(100);
+ImReflect::Input("big_vector", big_vector, budget);)");
+
+	static std::vector<search_item> big_vector(100000);
+	static int max_fields = 100;
+	ImGui::SliderInt("max fields", &max_fields, 1, 1000);
+
+	static auto budget = ImReflect::frame_budget();
+	budget.max_fields(static_cast<std::size_t>(max_fields));
+	ImReflect::Input("big_vector", big_vector, budget);
+	ImGui::Text("Rendered %zu, skipped %zu, %lld us", budget.rendered(), budget.skipped(), static_cast<long long>(budget.elapsed_microseconds()));
+
+	ImGui::Unindent();
+	ImGui::PopID();
+}
+
+// ========================================
+// Multi-object editing
+// ========================================
+static void multi_test() {
+	ImGui::SeparatorText("Multi-object editing");
+	ImGui::PushID("Multi-object editing");
+	ImGui::Indent();
+
+	static std::vector<search_item> items = {
+		{ "apple", 3, 0.2f },
+		{ "apple", 5, 0.2f },
+		{ "pear", 3, 0.3f },
+	};
+
+	ImGui::Text("Selection");
+	HelpMarker("Edits all selected items at once. Fields that differ are marked as mixed.");
+	IMGUI_SAMPLE_MULTI_CODE(R"(std::vector<search_item*> selection = ...;
+ImReflect::InputMulti("selection", selection);)");
+
+	static bool selected[3] = { true, true, false };
+	std::vector<search_item*> selection;
+	for (std::size_t i = 0; i < items.size(); ++i) {
+		ImGui::PushID(static_cast<int>(i));
+		ImGui::Checkbox(items[i].name.c_str(), &selected[i]);
+		ImGui::PopID();
+		if (i + 1 < items.size()) ImGui::SameLine();
+		if (selected[i]) selection.push_back(&items[i]);
+	}
+	ImReflect::InputMulti("selection", selection);
+
+	ImGui::Text("All items");
+	HelpMarker("Contiguous instances can be passed as pointer + count");
+	ImReflect::InputMultiContiguous("all", items.data(), items.size());
+
+	ImGui::Unindent();
+	ImGui::PopID();
+}
+
+// ========================================
+// Diff
+// ========================================
+static void diff_test() {
+	ImGui::SeparatorText("Diff");
+	ImGui::PushID("Diff");
+	ImGui::Indent();
+
+	static search_inventory saved = []() {
+		search_inventory result;
+		result.items = { { "sword", 1, 3.5f }, { "potion", 4, 0.1f } };
+		result.skills = { {"mining", 3}, {"fishing", 1} };
+		return result;
+		}();
+	static search_inventory live = saved;
+
+	ImGui::Text("Diff view");
+	HelpMarker("Edit the live copy, the table lists every path that differs from the saved copy");
+	IMGUI_SAMPLE_MULTI_CODE(R"(ImReflect::DiffView("changes", saved, live, "saved", "live");)");
+
+	if (ImGui::Button("Save")) saved = live;
+	ImGui::SameLine();
+	if (ImGui::Button("Revert")) live = saved;
+
+	ImReflect::DiffView("changes", saved, live, "saved", "live");
+	ImReflect::Input("live", live);
+
+	ImGui::Unindent();
+	ImGui::PopID();
+}
+
+// ========================================
+// Undo
+// ========================================
+static void undo_test() {
+	ImGui::SeparatorText("Undo");
+	ImGui::PushID("Undo");
+	ImGui::Indent();
+
+	ImGui::Text("Undo journal");
+	HelpMarker("Every finished edit is one entry, a whole drag is undone at once.\nCtrl+Z / Ctrl+Y work while this window is focused.");
+	IMGUI_SAMPLE_MULTI_CODE(R"(static ImReflect::undo_journal journal;
+ImReflect::UndoRedoButtons(journal);
+ImReflect::Input("item", item, journal);)");
+
+	static search_item item{ "lantern", 2, 1.5f };
+	static ImReflect::undo_journal journal;
+	ImReflect::UndoRedoButtons(journal);
+	ImGui::SameLine();
+	ImGui::TextDisabled("%zu undo, %zu redo", journal.undo_count(), journal.redo_count());
+	ImReflect::Input("item", item, journal);
+
+	ImGui::Unindent();
+	ImGui::PopID();
+}
+
+struct json_fixed {
+	int id = 1;
+	float arr[3] = { 0.5f, 1.0f, 2.0f };
+	char name[8] = "bolt";
+};
+IMGUI_REFLECT(json_fixed, id, arr, name)
+
+static void json_test() {
+	ImGui::SeparatorText("JSON");
+	ImGui::PushID("JSON");
+	ImGui::Indent();
+
+	ImGui::Text("Save and load");
+	HelpMarker("Edit the inventory, save it, change it again and load it back.\nThe text below is what was last saved.");
+	IMGUI_SAMPLE_MULTI_CODE(R"(std::string json;
+ImReflect::WriteJson(inventory, json, { 2 });
+ImReflect::json_result result = ImReflect::ReadJson(json, inventory);)");
+
+	static search_inventory inventory = []() {
+		search_inventory result;
+		result.items = { { "sword", 1, 3.5f }, { "potion", 4, 0.1f } };
+		result.skills = { {"mining", 3}, {"fishing", 1} };
+		result.equipped = search_item{ "lantern", 1, 1.5f };
+		return result;
+		}();
+	static std::string json;
+	static ImReflect::json_result result;
+	if (ImGui::Button("Save")) {
+		json.clear();
+		ImReflect::WriteJson(inventory, json, { 2 });
+	}
+	ImGui::SameLine();
+	ImGui::BeginDisabled(json.empty());
+	if (ImGui::Button("Load")) result = ImReflect::ReadJson(json, inventory);
+	ImGui::EndDisabled();
+	if (!result) {
+		ImGui::SameLine();
+		ImGui::TextColored(ImVec4(1, 0.4f, 0.4f, 1), "%s at %zu", result.error, result.offset);
+	}
+
+	ImReflect::Input("inventory", inventory);
+	ImGui::TextUnformatted(json.c_str());
+
+	ImGui::Text("C arrays");
+	HelpMarker("Fixed size arrays are written like std::array and read back in place.\nThe text is read into a zeroed copy, which must not differ from the original.");
+	IMGUI_SAMPLE_MULTI_CODE(R"(struct json_fixed { int id; float arr[3]; char name[8]; };
+const std::string json = ImReflect::ToJson(fixed);
+ImReflect::ReadJson(json, copy);)");
+
+	static json_fixed fixed;
+	ImReflect::Input("fixed", fixed);
+	const std::string fixed_json = ImReflect::ToJson(fixed);
+	json_fixed copy{ 0, {}, {} };
+	const ImReflect::json_result fixed_result = ImReflect::ReadJson(fixed_json, copy);
+	if (!fixed_result) {
+		ImGui::TextColored(ImVec4(1, 0.4f, 0.4f, 1), "%s at %zu", fixed_result.error, fixed_result.offset);
+	} else if (!ImReflect::Diff(fixed, copy).empty()) {
+		ImGui::TextColored(ImVec4(1, 0.4f, 0.4f, 1), "round trip differs");
+	} else {
+		ImGui::TextDisabled("round trip ok");
+	}
+	ImGui::TextUnformatted(fixed_json.c_str());
+
+	ImGui::Unindent();
+	ImGui::PopID();
+}
+
+struct binary_sample {
+	std::string name = "recording";
+	int rate = 60;
+	std::vector<float> samples;
+};
+IMGUI_REFLECT(binary_sample, name, rate, samples)
+
+static void binary_test() {
+	ImGui::SeparatorText("Binary");
+	ImGui::PushID("Binary");
+	ImGui::Indent();
+
+	ImGui::Text("Snapshot");
+	HelpMarker("Take a snapshot, edit the values, then restore it.\nThe samples vector is copied with a single memcpy.");
+	IMGUI_SAMPLE_MULTI_CODE(R"(std::vector<unsigned char> snapshot;
+ImReflect::WriteBinary(data, snapshot);
+ImReflect::ReadBinary(snapshot.data(), snapshot.size(), data);)");
+
+	static binary_sample data = []() {
+		binary_sample result;
+		result.samples.resize(10000);
+		for (std::size_t i = 0; i < result.samples.size(); ++i) result.samples[i] = static_cast<float>(i) * 0.5f;
+		return result;
+		}();
+	static std::vector<unsigned char> snapshot;
+	static ImReflect::binary_result result;
+	if (ImGui::Button("Take snapshot")) {
+		snapshot.clear();
+		ImReflect::WriteBinary(data, snapshot);
+	}
+	ImGui::SameLine();
+	ImGui::BeginDisabled(snapshot.empty());
+	if (ImGui::Button("Restore")) result = ImReflect::ReadBinary(snapshot.data(), snapshot.size(), data);
+	ImGui::EndDisabled();
+	ImGui::SameLine();
+	if (result) {
+		ImGui::TextDisabled("%zu bytes", snapshot.size());
+	} else {
+		ImGui::TextColored(ImVec4(1, 0.4f, 0.4f, 1), "%s at %zu", result.error, result.offset);
+	}
+
+	ImReflect::Input("data", data);
+
+	ImGui::Unindent();
+	ImGui::PopID();
+}
+
+struct preset_player {
+	std::string name = "hero";
+	float health = 75.0f;
+	int level = 3;
+	std::vector<int> inventory = { 1, 2, 3 };
+};
+IMGUI_REFLECT(preset_player, name, health, level, inventory)
+
+static void preset_test() {
+	ImGui::SeparatorText("Presets");
+	ImGui::PushID("Presets");
+	ImGui::Indent();
+
+	ImGui::Text("Settings preset");
+	HelpMarker("Edit the preset text, only the entries that changed are applied again.\nWith preset.watch(\"ui.preset\") and preset.poll() the same happens when the file changes on disk.");
+	IMGUI_SAMPLE_MULTI_CODE(R"(static ImReflect::settings_preset preset(settings);
+preset.bind<float>("float").bind<preset_player>("player");
+preset.apply(text);)");
+
+	static ImSettings settings;
+	static ImReflect::settings_preset preset(settings);
+	static std::string text =
+		"[float]\n"
+		"as_slider\n"
+		"min = 0\n"
+		"max = 100\n"
+		"format = \"%.1f hp\"\n"
+		"\n"
+		"[player.level]\n"
+		"as_drag\n"
+		"min = 1\n"
+		"max = 99\n";
+	static ImReflect::preset_result result = []() {
+		preset.bind<float>("float").bind<int>("int").bind<preset_player>("player");
+		return preset.apply(text);
+		}();
+
+	if (ImGui::InputTextMultiline("##preset", &text, ImVec2(0, ImGui::GetTextLineHeight() * 12))) {
+		result = preset.apply(text);
+	}
+	if (!result) {
+		ImGui::TextColored(ImVec4(1, 0.4f, 0.4f, 1), "line %zu: %s", result.line, result.error);
+	} else {
+		ImGui::TextDisabled("%zu entries applied, float generation %u", result.applied, settings.get<float>().generation());
+	}
+
+	static preset_player player;
+	ImReflect::Input("player", player, settings);
+
+	ImGui::Unindent();
+	ImGui::PopID();
+}
+
+static void record_test() {
+	ImGui::SeparatorText("Record");
+	ImGui::PushID("Record");
+	ImGui::Indent();
+
+	ImGui::Text("Edit recording");
+	HelpMarker("Every edit is recorded with its path, old and new value.\nReplay applies the log to a copy of the object from when recording started, without any widgets.");
+	IMGUI_SAMPLE_MULTI_CODE(R"(static ImReflect::edit_recorder recorder(player);
+ImReflect::Input("player", player, settings, recorder);
+ImReflect::Replay(recorder.log(), start);)");
+
+	static preset_player player;
+	static preset_player start = player;
+	static ImReflect::edit_recorder recorder(player);
+	static ImReflect::replay_result result;
+	static bool replayed = false;
+
+	ImGui::Text("%zu edits, %zu bytes", recorder.edit_count(), recorder.log().size());
+	if (ImGui::Button("Restart recording")) {
+		start = player;
+		recorder.clear();
+		replayed = false;
+	}
+	ImGui::SameLine();
+	if (ImGui::Button("Replay")) {
+		preset_player copy = start;
+		result = ImReflect::Replay(recorder.log(), copy);
+		replayed = true;
+		if (result && !ImReflect::Diff(copy, player).empty()) result.error = "replay differs from the live object";
+	}
+	if (replayed) {
+		ImGui::SameLine();
+		if (result) {
+			ImGui::TextDisabled("%zu edits replayed, same as live", result.applied);
+		} else {
+			ImGui::TextColored(ImVec4(1, 0.4f, 0.4f, 1), "%s (%zu applied)", result.error, result.applied);
+		}
+	}
+
+	ImSettings settings;
+	ImReflect::Input("player", player, settings, recorder);
+
+	ImGui::Unindent();
+	ImGui::PopID();
+}
+
+struct proxy_agent {
+	std::string name;
+	float x = 0.0f;
+	float speed = 1.0f;
+};
+IMGUI_REFLECT(proxy_agent, name, x, speed)
+
+struct proxy_world {
+	int step = 0;
+	bool paused = false;
+	std::vector<proxy_agent> agents;
+};
+IMGUI_REFLECT(proxy_world, step, paused, agents)
+
+/* Owns a world on its own thread, the UI only ever sees published copies */
+struct proxy_worker {
+	ImReflect::thread_proxy<proxy_world> proxy;
+	std::atomic<bool> running{ true };
+	std::thread thread;
+
+	proxy_worker() {
+		thread = std::thread([this]() {
+			proxy_world world;
+			world.agents = { { "alpha", 0.0f, 1.0f }, { "beta", 0.0f, 2.0f }, { "gamma", 0.0f, 0.5f } };
+			while (running) {
+				proxy.apply_edits(world); /* safe point */
+				if (!world.paused) {
+					++world.step;
+					for (proxy_agent& agent : world.agents) {
+						agent.x += agent.speed * 0.01f;
+						if (agent.x > 100.0f) agent.x = 0.0f;
+					}
+				}
+				proxy.publish(world);
+				std::this_thread::sleep_for(std::chrono::milliseconds(1));
+			}
+			});
+	}
+	~proxy_worker() {
+		running = false;
+		thread.join();
+	}
+};
+
+static void proxy_test() {
+	ImGui::SeparatorText("Thread Proxy");
+	ImGui::PushID("Thread Proxy");
+	ImGui::Indent();
+
+	ImGui::Text("Object owned by a worker thread");
+	HelpMarker("The worker publishes a copy every step, only fields whose hash changed are copied.\nEdits are queued and applied by the worker between two steps.");
+	IMGUI_SAMPLE_MULTI_CODE(R"(proxy.apply_edits(world); // worker
+proxy.publish(world);     // worker
+proxy.input("world", settings); // UI)");
+
+	static proxy_worker worker;
+	ImGui::TextDisabled("%zu of %zu fields copied by the last publish", worker.proxy.copied_fields(), worker.proxy.field_count());
+	ImSettings settings;
+	worker.proxy.input("world", settings);
+
+	ImGui::Unindent();
+	ImGui::PopID();
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+static void remote_test() {
+	ImGui::SeparatorText("Remote");
+	ImGui::PushID("Remote");
+	ImGui::Indent();
+
+	ImGui::Text("Remote inspector");
+	HelpMarker("The server and the client normally live in different processes, here both run in the demo.\nThe server sends only the blocks of the snapshot that changed, edits on the client go back as an edit log.");
+	IMGUI_SAMPLE_MULTI_CODE(R"(server.add("sim", sim).listen("/tmp/imreflect-demo.sock");
+client.add<binary_sample>("sim").connect("/tmp/imreflect-demo.sock");
+server.tick(); client.poll();
+client.input<binary_sample>("sim", settings);)");
+
+	static binary_sample sim = []() {
+		binary_sample result;
+		result.samples.resize(4096);
+		return result;
+		}();
+	static ImReflect::remote_server server;
+	static ImReflect::remote_client client;
+	static bool started = [&]() {
+		server.add("sim", sim).listen("/tmp/imreflect-demo.sock");
+		return client.add<binary_sample>("sim").connect("/tmp/imreflect-demo.sock");
+		}();
+
+	/* The "simulation", one sample changes per frame */
+	static std::size_t cursor = 0;
+	sim.samples[cursor] = static_cast<float>((ImGui::GetFrameCount() * sim.rate) % 1000) * 0.001f;
+	cursor = (cursor + 1) % sim.samples.size();
+
+	server.tick();
+	client.poll();
+
+	if (!started) {
+		ImGui::TextDisabled("Couldn't connect");
+	} else {
+		ImGui::TextDisabled("server value of rate: %d", sim.rate);
+		ImSettings settings;
+		client.input<binary_sample>("sim", settings);
+	}
+
+	ImGui::Unindent();
+	ImGui::PopID();
+}
+
+struct shared_body {
+	float x = 0.0f, y = 1.0f;
+	float velocity_x = 1.0f, velocity_y = 0.0f;
+	float mass = 1.0f;
+};
+IMGUI_REFLECT(shared_body, x, y, velocity_x, velocity_y, mass)
+
+struct shared_physics {
+	int step = 0;
+	float gravity = -9.8f;
+	std::array<shared_body, 4> bodies;
+};
+IMGUI_REFLECT(shared_physics, step, gravity, bodies)
+
+static void shared_test() {
+	ImGui::SeparatorText("Shared Memory");
+	ImGui::PushID("Shared Memory");
+	ImGui::Indent();
+
+	ImGui::Text("Shared memory view");
+	HelpMarker("The owner writes the object in place in a shared memory segment, the view takes a consistent copy every frame.\nEdits go back through a lock-free queue. Normally the owner is another process.");
+	IMGUI_SAMPLE_MULTI_CODE(R"(owner.create("/imreflect-demo");
+view.open("/imreflect-demo");
+owner.apply_edits(); step(*owner.write());
+view.input("physics", settings);)");
+
+	static ImReflect::shared_object<shared_physics> owner;
+	static ImReflect::shared_view<shared_physics> view;
+	static bool opened = owner.create("/imreflect-demo") && view.open("/imreflect-demo");
+
+	if (!opened) {
+		ImGui::TextDisabled("Shared memory not available");
+	} else {
+		/* The "simulation" */
+		owner.apply_edits();
+		{
+			auto state = owner.write();
+			state->step++;
+			for (shared_body& body : state->bodies) {
+				body.velocity_y += state->gravity * 0.001f;
+				body.x += body.velocity_x * 0.001f;
+				body.y += body.velocity_y * 0.001f;
+				if (body.y < 0.0f) body.velocity_y = -body.velocity_y;
+			}
+		}
+
+		ImGui::TextDisabled("version %u", view.version());
+		ImSettings settings;
+		view.input("physics", settings);
+	}
+
+	ImGui::Unindent();
+	ImGui::PopID();
+}
+#endif
+
 // ========================================
 // Main
 // ========================================
@@ -2560,11 +3429,78 @@ namespace svh {
 			function_test();
 			ImGui::EndTabItem();
 		}
+		if (ImGui::BeginTabItem("Atomic")) {
+			// Atomic test
+			atomic_test();
+			ImGui::EndTabItem();
+		}
 		if (ImGui::BeginTabItem("Complex Object")) {
 			// Complex Object test
 			complex_object_test();
 			ImGui::EndTabItem();
 		}
+		if (ImGui::BeginTabItem("Search")) {
+			// Search test
+			search_test();
+			ImGui::EndTabItem();
+		}
+		if (ImGui::BeginTabItem("Frame Budget")) {
+			// Frame budget test
+			budget_test();
+			ImGui::EndTabItem();
+		}
+		if (ImGui::BeginTabItem("Multi Edit")) {
+			// Multi-object editing test
+			multi_test();
+			ImGui::EndTabItem();
+		}
+		if (ImGui::BeginTabItem("Diff")) {
+			// Diff test
+			diff_test();
+			ImGui::EndTabItem();
+		}
+		if (ImGui::BeginTabItem("Undo")) {
+			// Undo test
+			undo_test();
+			ImGui::EndTabItem();
+		}
+		if (ImGui::BeginTabItem("JSON")) {
+			// JSON test
+			json_test();
+			ImGui::EndTabItem();
+		}
+		if (ImGui::BeginTabItem("Binary")) {
+			// Binary test
+			binary_test();
+			ImGui::EndTabItem();
+		}
+		if (ImGui::BeginTabItem("Presets")) {
+			// Preset test
+			preset_test();
+			ImGui::EndTabItem();
+		}
+		if (ImGui::BeginTabItem("Record")) {
+			// Record test
+			record_test();
+			ImGui::EndTabItem();
+		}
+		if (ImGui::BeginTabItem("Thread Proxy")) {
+			// Thread proxy test
+			proxy_test();
+			ImGui::EndTabItem();
+		}
+#if defined(__unix__) || defined(__APPLE__)
+		if (ImGui::BeginTabItem("Remote")) {
+			// Remote test
+			remote_test();
+			ImGui::EndTabItem();
+		}
+		if (ImGui::BeginTabItem("Shared Memory")) {
+			// Shared memory test
+			shared_test();
+			ImGui::EndTabItem();
+		}
+#endif
 
 		ImGui::EndTabBar();
 	}
@@ -166,8 +166,21 @@ def main():
         # ImReflect headers (in dependency order)
         repo_root / "ImReflect_entry.hpp",
         repo_root / "ImReflect_helper.hpp",
+        repo_root / "ImReflect_traits.hpp",
         repo_root / "ImReflect_primitives.hpp",
         repo_root / "ImReflect_std.hpp",
+        repo_root / "ImReflect_search.hpp",
+        repo_root / "ImReflect_multi.hpp",
+        repo_root / "ImReflect_diff.hpp",
+        repo_root / "ImReflect_undo.hpp",
+        repo_root / "ImReflect_json.hpp",
+        repo_root / "ImReflect_binary.hpp",
+        repo_root / "ImReflect_clipboard.hpp",
+        repo_root / "ImReflect_preset.hpp",
+        repo_root / "ImReflect_record.hpp",
+        repo_root / "ImReflect_remote.hpp",
+        repo_root / "ImReflect_shared.hpp",
+        repo_root / "ImReflect_proxy.hpp",
     ]
     
     # Process each file